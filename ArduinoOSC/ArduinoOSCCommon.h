@@ -24,6 +24,8 @@
 #include "ArduinoOSC/OscUdpMap.h"
 #include "ArduinoOSC/OSCServer.h"
 #include "ArduinoOSC/OSCClient.h"
+#include "ArduinoOSC/OscClockSync.h"
+#include "ArduinoOSC/OscReliableLink.h"
 
 namespace arduino {
 namespace osc {
@@ -66,6 +68,41 @@ namespace osc {
 #endif
         }
 
+        template <typename... Ts, typename F>
+        void subscribe(const uint16_t port, const OscSchema<Ts...>& schema, F&& func) {
+#if defined(ARDUINOOSC_ENABLE_WIFI) && (defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_RP2040))
+            if (WiFi.getMode() != WIFI_OFF)
+                OscServerManager<S>::getInstance().getServer(port).subscribe(schema, std::forward<F>(func));
+            else
+                LOG_ERROR(F("WiFi is not enabled. Subscribing OSC failed."));
+#else
+            OscServerManager<S>::getInstance().getServer(port).subscribe(schema, std::forward<F>(func));
+#endif
+        }
+
+        template <typename F>
+        void subscribeTyped(const uint16_t port, const String& addr, F&& func) {
+#if defined(ARDUINOOSC_ENABLE_WIFI) && (defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_RP2040))
+            if (WiFi.getMode() != WIFI_OFF)
+                OscServerManager<S>::getInstance().getServer(port).subscribeTyped(addr, std::forward<F>(func));
+            else
+                LOG_ERROR(F("WiFi is not enabled. Subscribing OSC failed."));
+#else
+            OscServerManager<S>::getInstance().getServer(port).subscribeTyped(addr, std::forward<F>(func));
+#endif
+        }
+
+        void subscribeBlob(const uint16_t port, const String& addr, OscBlobReassembler& r) {
+#if defined(ARDUINOOSC_ENABLE_WIFI) && (defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_RP2040))
+            if (WiFi.getMode() != WIFI_OFF)
+                OscServerManager<S>::getInstance().getServer(port).subscribeBlob(addr, r);
+            else
+                LOG_ERROR(F("WiFi is not enabled. Subscribing OSC failed."));
+#else
+            OscServerManager<S>::getInstance().getServer(port).subscribeBlob(addr, r);
+#endif
+        }
+
         template <typename... Ts>
         void subscribeMulticast(const IPAddress iface, const IPAddress multicast, const uint16_t port, const String& addr, Ts&&... ts) {
 #if defined(ARDUINOOSC_ENABLE_WIFI) && (defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_RP2040))
@@ -80,6 +117,14 @@ namespace osc {
 
 
 
+        // drain pending packets of all ports within the budget in parse() (0 means no limit)
+        void setParseBudget(const size_t max_packets, const uint32_t max_us = 0) {
+            OscServerManager<S>::getInstance().setParseBudget(max_packets, max_us);
+        }
+        void resetParseBudget() {
+            OscServerManager<S>::getInstance().resetParseBudget();
+        }
+
         void parse() {
 #if defined(ARDUINOOSC_ENABLE_WIFI) && (defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_RP2040))
             if (this->isWiFiConnected() || this->isWiFiModeAP()) {
@@ -98,16 +143,79 @@ namespace osc {
             return OscClientManager<S>::getInstance().getClient();
         }
 
+        // the cached multicast interface is looked up again (called automatically on ESP32)
+        void linkChanged() {
+            OscClientManager<S>::getInstance().linkChanged();
+        }
+
         template <typename... Ts>
-        void send(const String& ip, const uint16_t port, const String& addr, Ts&&... ts) {
+        bool send(const String& ip, const uint16_t port, const String& addr, Ts&&... ts) {
 #if defined(ARDUINOOSC_ENABLE_WIFI) && (defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_RP2040))
             if (this->isWiFiConnected() || this->isWiFiModeAP()) {
-                OscClientManager<S>::getInstance().send(ip, port, addr, std::forward<Ts>(ts)...);
+                return OscClientManager<S>::getInstance().send(ip, port, addr, std::forward<Ts>(ts)...);
             } else {
                 LOG_ERROR(F("WiFi is not connected. Please connected to WiFi"));
+                return false;
             }
 #else
-            OscClientManager<S>::getInstance().send(ip, port, addr, std::forward<Ts>(ts)...);
+            return OscClientManager<S>::getInstance().send(ip, port, addr, std::forward<Ts>(ts)...);
+#endif
+        }
+
+        template <typename... Ts, typename... Args>
+        bool send(const String& ip, const uint16_t port, OscSchema<Ts...>& schema, const Args&... args) {
+#if defined(ARDUINOOSC_ENABLE_WIFI) && (defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_RP2040))
+            if (this->isWiFiConnected() || this->isWiFiModeAP()) {
+                return OscClientManager<S>::getInstance().send(ip, port, schema, args...);
+            } else {
+                LOG_ERROR(F("WiFi is not connected. Please connected to WiFi"));
+                return false;
+            }
+#else
+            return OscClientManager<S>::getInstance().send(ip, port, schema, args...);
+#endif
+        }
+
+        // send the message to every endpoint of the group, encoded only once
+        template <typename... Ts>
+        bool send(const OscFanout& group, const String& addr, Ts&&... ts) {
+#if defined(ARDUINOOSC_ENABLE_WIFI) && (defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_RP2040))
+            if (this->isWiFiConnected() || this->isWiFiModeAP()) {
+                return OscClientManager<S>::getInstance().send(group, addr, std::forward<Ts>(ts)...);
+            } else {
+                LOG_ERROR(F("WiFi is not connected. Please connected to WiFi"));
+                return false;
+            }
+#else
+            return OscClientManager<S>::getInstance().send(group, addr, std::forward<Ts>(ts)...);
+#endif
+        }
+
+        template <typename... Ts, typename... Args>
+        bool send(const OscFanout& group, OscSchema<Ts...>& schema, const Args&... args) {
+#if defined(ARDUINOOSC_ENABLE_WIFI) && (defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_RP2040))
+            if (this->isWiFiConnected() || this->isWiFiModeAP()) {
+                return OscClientManager<S>::getInstance().send(group, schema, args...);
+            } else {
+                LOG_ERROR(F("WiFi is not connected. Please connected to WiFi"));
+                return false;
+            }
+#else
+            return OscClientManager<S>::getInstance().send(group, schema, args...);
+#endif
+        }
+
+        // send the buffer of the chunker in the chunk messages
+        bool sendBlob(const String& ip, const uint16_t port, OscBlobChunker& chunker) {
+#if defined(ARDUINOOSC_ENABLE_WIFI) && (defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_RP2040))
+            if (this->isWiFiConnected() || this->isWiFiModeAP()) {
+                return OscClientManager<S>::getInstance().sendBlob(ip, port, chunker);
+            } else {
+                LOG_ERROR(F("WiFi is not connected. Please connected to WiFi"));
+                return false;
+            }
+#else
+            return OscClientManager<S>::getInstance().sendBlob(ip, port, chunker);
 #endif
         }
 
@@ -123,29 +231,50 @@ namespace osc {
         void end_bundle() {
             OscClientManager<S>::getInstance().end_bundle();
         }
-        void send_bundle(const String& ip, const uint16_t port) {
+        bool send_bundle(const String& ip, const uint16_t port) {
 #if defined(ARDUINOOSC_ENABLE_WIFI) && (defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_RP2040))
             if (this->isWiFiConnected() || this->isWiFiModeAP()) {
-                OscClientManager<S>::getInstance().send_bundle(ip, port);
+                return OscClientManager<S>::getInstance().send_bundle(ip, port);
             } else {
                 LOG_ERROR(F("WiFi is not connected. Please connected to WiFi"));
+                return false;
             }
 #else
-            OscClientManager<S>::getInstance().send_bundle(ip, port);
+            return OscClientManager<S>::getInstance().send_bundle(ip, port);
 #endif
         }
 
+        bool send_bundle(const OscFanout& group) {
+#if defined(ARDUINOOSC_ENABLE_WIFI) && (defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_RP2040))
+            if (this->isWiFiConnected() || this->isWiFiModeAP()) {
+                return OscClientManager<S>::getInstance().send_bundle(group);
+            } else {
+                LOG_ERROR(F("WiFi is not connected. Please connected to WiFi"));
+                return false;
+            }
+#else
+            return OscClientManager<S>::getInstance().send_bundle(group);
+#endif
+        }
+
+        // send due publishers to the same host in the bundles up to mtu bytes
+        void usePublishBatching(const bool b, const size_t mtu = ARDUINOOSC_PUBLISH_BATCH_MTU) {
+            OscClientManager<S>::getInstance().usePublishBatching(b, mtu);
+        }
+
 #endif // ARDUINOOSC_DISABLE_BUNDLE
 
-        void post() {
+        // returns microseconds until the next publish
+        uint32_t post() {
 #if defined(ARDUINOOSC_ENABLE_WIFI) && (defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_RP2040))
             if (this->isWiFiConnected() || this->isWiFiModeAP()) {
-                OscClientManager<S>::getInstance().post();
+                return OscClientManager<S>::getInstance().post();
             } else {
                 LOG_ERROR(F("WiFi is not connected. Please connected to WiFi"));
+                return OscPublishQueue::NO_DEADLINE;
             }
 #else
-            OscClientManager<S>::getInstance().post();
+            return OscClientManager<S>::getInstance().post();
 #endif
         }
 
@@ -177,14 +306,109 @@ namespace osc {
 #endif
         }
 
+        // the value is encoded once per tick and sent to every endpoint of the group
+        template <typename... Ts>
+        OscPublishElementRef publish(const OscFanout& group, const String& addr, Ts&&... ts) {
+#if defined(ARDUINOOSC_ENABLE_WIFI) && (defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_RP2040))
+            if (WiFi.getMode() != WIFI_OFF)
+                return OscClientManager<S>::getInstance().publish(group, addr, std::forward<Ts>(ts)...);
+            else {
+                LOG_ERROR(F("WiFi is not enabled. Publishing OSC failed."));
+                return nullptr;
+            }
+#else
+            return OscClientManager<S>::getInstance().publish(group, addr, std::forward<Ts>(ts)...);
+#endif
+        }
+
         OscPublishElementRef getPublishElementRef(const String& ip, const uint16_t port, const String& addr) {
             return OscClientManager<S>::getInstance().getPublishElementRef(ip, port, addr);
         }
+        OscPublishElementRef getPublishElementRef(const OscFanout& group, const String& addr) {
+            return OscClientManager<S>::getInstance().getPublishElementRef(group, addr);
+        }
+
+#ifdef ARDUINOOSC_ENABLE_STATS
+        const OscDestinationStats* getPublishStats(const String& ip, const uint16_t port, const String& addr) const {
+            return OscClientManager<S>::getInstance().getPublishStats(ip, port, addr);
+        }
+        void resetPublishStats() {
+            OscClientManager<S>::getInstance().resetPublishStats();
+        }
+#endif
+
+#ifdef ARDUINOOSC_ENABLE_STATS
+        // stats
+
+        // publish the counters of the server to addr (packets, bytes, dropped, parse failures, messages, unmatched)
+        // and the latency histogram to addr + "/latency" (count of each log2 bucket in microseconds)
+        void publishStats(const uint16_t server_port, const String& ip, const uint16_t port, const String& addr, const float rate = 1.f) {
+            OscServerStats& s = getServer(server_port).stats();
+            OscPublishElementRef counters = publish(ip, port, addr, s.packets, s.bytes, s.dropped, s.parse_failures, s.messages, s.unmatched);
+            if (counters) counters->setFrameRate(rate);
+            OscPublishElementRef latency = publishLatency(ip, port, addr + "/latency", s.latency, std::make_index_sequence<OscLatencyHistogram::NUM_BUCKETS>());
+            if (latency) latency->setFrameRate(rate);
+        }
+
+#endif
+
+        // clock sync
+
+        // answer the clock sync requests on the port as the master
+        void serveClockSync(const uint16_t port) {
+            OscClockSync<S>::getInstance().serve(port);
+        }
+        // synchronize OscClock to the master periodically in update()
+        void beginClockSync(const String& ip, const uint16_t port, const uint16_t recv_port, const uint32_t interval_ms = 1000) {
+            OscClockSync<S>::getInstance().begin(ip, port, recv_port, interval_ms);
+        }
+        void endClockSync() {
+            OscClockSync<S>::getInstance().end();
+        }
+        const OscClockSync<S>& getClockSync() const {
+            return OscClockSync<S>::getInstance();
+        }
+
+        // reliable delivery
+
+        // ACK / NACK of the reliable messages are received on ack_port
+        void beginReliable(const uint16_t ack_port) {
+            OscReliableLink<S>::getInstance().begin(ack_port);
+        }
+        void endReliable() {
+            OscReliableLink<S>::getInstance().end();
+        }
+        // messages sent to the address are resent until acknowledged, other addresses are not affected
+        bool reliable(const String& addr) {
+            return OscReliableLink<S>::getInstance().add(addr);
+        }
+        // accept the reliable messages on the port without duplicates
+        void serveReliable(const uint16_t port) {
+            OscReliableLink<S>::getInstance().serve(port);
+        }
+        const OscReliableLink<S>& getReliable() const {
+            return OscReliableLink<S>::getInstance();
+        }
+
+        // state query
+
+        // keep the latest message of every address sent by the client,
+        // and reply them to /state/dump [int32 reply port] [string address prefix] received on the port
+        void serveState(const uint16_t port) {
+            OscClientManager<S>::getInstance().useStateCache(true);
+            subscribe(port, OscStateCache::DUMP_ADDRESS, [](const OscMessage& m) {
+                OscClientManager<S>::getInstance().dumpState(m);
+            });
+        }
+        const OscStateCache& getStateCache() const {
+            return OscClientManager<S>::getInstance().getStateCache();
+        }
 
         // update both server and client
 
         void update() {
             parse();
+            OscClockSync<S>::getInstance().update();
             post();
         }
 
@@ -199,6 +423,13 @@ namespace osc {
             return (mode == WIFI_AP) || (mode == WIFI_AP_STA);
         }
 #endif
+
+#ifdef ARDUINOOSC_ENABLE_STATS
+        template <size_t... Is>
+        OscPublishElementRef publishLatency(const String& ip, const uint16_t port, const String& addr, OscLatencyHistogram& h, std::index_sequence<Is...>&&) {
+            return publish(ip, port, addr, h.buckets[Is]...);
+        }
+#endif
     };
 
 }  // namespace osc
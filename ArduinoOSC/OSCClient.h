@@ -11,9 +11,19 @@
 
 #include "OscMessage.h"
 #include "OscEncoder.h"
+#include "OscSchema.h"
+#include "OscBlob.h"
+#include "OscFanout.h"
+#include "OscReliable.h"
+#include "OscStateCache.h"
 #include "OscUdpMap.h"
+#include "OscStats.h"
 #include <Log4Esp.h>
 
+#ifndef ARDUINOOSC_PUBLISH_CONGESTION_US
+#define ARDUINOOSC_PUBLISH_CONGESTION_US 2000  // sending slower than this is regarded as congestion
+#endif
+
 namespace arduino {
 namespace osc {
     namespace client {
@@ -21,15 +31,80 @@ namespace osc {
         using namespace message;
 
         namespace element {
-            struct Base {
+            struct Base : public RefCounted, public ArenaAllocated {
                 uint32_t last_publish_us {0};
                 uint32_t interval_us {33333};  // 30 fps
+                bool has_published {false};
+
+                // change-driven mode
+                bool is_change_driven {false};
+                bool has_payload {false};
+                uint32_t payload_hash {0};
+                uint32_t last_sent_us {0};
+                uint32_t keep_alive_us {0};
+
+                // adaptive mode
+                uint32_t backoff_us {0};        // added to the interval while the link is congested
+                uint32_t max_interval_us {0};   // 0: adaptive mode is disabled
+
+                // wrap-safe as long as the interval is shorter than about 71 minutes
+                bool next() const { return !has_published || ((uint32_t)(micros() - last_publish_us) >= currentIntervalUsec()); }
+                uint32_t currentIntervalUsec() const { return interval_us + backoff_us; }
+                void setFrameRate(float fps) { setIntervalUsec((uint32_t)(1000000.f / fps)); }
+                void setIntervalUsec(const uint32_t us) {
+                    interval_us = us;
+                    ++revision();
+                }
+                void setIntervalMsec(const float ms) { setIntervalUsec((uint32_t)(ms * 1000.f)); }
+                void setIntervalSec(const float sec) { setIntervalUsec((uint32_t)(sec * 1000.f * 1000.f)); }
+
+                // the value is checked in the interval, but sent only if the encoded payload is changed
+                // or keep_alive_us has passed since it was sent last time
+                void setChangeDriven(const bool b, const uint32_t keep_alive = 1000000) {
+                    is_change_driven = b;
+                    keep_alive_us = keep_alive;
+                    has_payload = false;
+                }
+                bool isChangeDriven() const { return is_change_driven; }
+
+                // the interval is extended up to max_interval while sending fails or takes longer than
+                // ARDUINOOSC_PUBLISH_CONGESTION_US, and is recovered gradually while sending succeeds
+                void setAdaptive(const bool b, const uint32_t max_interval = 1000000) {
+                    max_interval_us = b ? max_interval : 0;
+                    backoff_us = 0;
+                }
+                bool isAdaptive() const { return max_interval_us != 0; }
+                uint32_t backoffUsec() const { return backoff_us; }
+
+                // returns false if the payload of m is same as the last sent one and the keep-alive has not passed
+                bool isChanged(const Message& m, const uint32_t now) {
+                    if (!is_change_driven) return true;
+                    const uint32_t h = fnv1a(m.argumentsData(), m.argumentsSize(), fnv1a(m.typeTags().c_str(), m.typeTags().length()));
+                    if (has_payload && (h == payload_hash) && ((uint32_t)(now - last_sent_us) < keep_alive_us)) return false;
+                    payload_hash = h;
+                    last_sent_us = now;
+                    has_payload = true;
+                    return true;
+                }
+
+                void onSent(const bool success, const uint32_t elapsed_us) {
+                    // resend the payload in the next interval if it could not be sent
+                    if (!success) has_payload = false;
+                    if (!max_interval_us) return;
+                    if (!success || (elapsed_us > ARDUINOOSC_PUBLISH_CONGESTION_US)) {
+                        const uint32_t max_backoff = (max_interval_us > interval_us) ? (max_interval_us - interval_us) : 0;
+                        const uint32_t step = backoff_us ? backoff_us : (interval_us ? interval_us : 1000);
+                        backoff_us = (backoff_us + step > max_backoff) ? max_backoff : (backoff_us + step);
+                    } else if (backoff_us) {
+                        backoff_us -= backoff_us / 8 + 1;
+                    }
+                }
 
-                bool next() const { return micros() >= (last_publish_us + interval_us); }
-                void setFrameRate(float fps) { interval_us = (uint32_t)(1000000.f / fps); }
-                void setIntervalUsec(const uint32_t us) { interval_us = us; }
-                void setIntervalMsec(const float ms) { interval_us = (uint32_t)(ms * 1000.f); }
-                void setIntervalSec(const float sec) { interval_us = (uint32_t)(sec * 1000.f * 1000.f); }
+                // incremented when any interval is changed, so that the publish queue is rebuilt
+                static uint32_t& revision() {
+                    static uint32_t r {0};
+                    return r;
+                }
 
                 void init(Message& m, const String& addr) { m.init(addr); }
 
@@ -118,19 +193,38 @@ namespace osc {
             uint16_t port;
             String addr;
             bool is_multicast;
+            const Fanout* fanout {nullptr};  // not owned, packets are sent to all endpoints of the group
+
+            // caches to publish, they are not copied and rebuilt when needed
+            mutable IPAddress ip_addr;
+            mutable uint8_t ip_state {IP_UNRESOLVED};
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+            mutable Blob header;  // encoded address and type tags
+            mutable String header_tags;
+#endif
+#ifdef ARDUINOOSC_ENABLE_STATS
+            mutable DestinationStats stats;
+#endif
+
+            enum : uint8_t { IP_UNRESOLVED, IP_ADDRESS, IP_HOSTNAME };
 
             Destination(const Destination& dest)
-            : ip(dest.ip), port(dest.port), addr(dest.addr), is_multicast(dest.is_multicast) {}
+            : ip(dest.ip), port(dest.port), addr(dest.addr), is_multicast(dest.is_multicast), fanout(dest.fanout) {}
             Destination(Destination&& dest)
-            : ip(std::move(dest.ip)), port(std::move(dest.port)), addr(std::move(dest.addr)), is_multicast(std::move(dest.is_multicast)) {}
+            : ip(std::move(dest.ip)), port(std::move(dest.port)), addr(std::move(dest.addr)), is_multicast(std::move(dest.is_multicast)), fanout(dest.fanout) {}
             Destination(const String& ip, const uint16_t port, const String& addr, bool isMulticast = false)
             : ip(ip), port(port), addr(addr), is_multicast(isMulticast) {}
+            Destination(const Fanout& group, const String& addr)
+            : ip(""), port(0), addr(addr), is_multicast(false), fanout(&group) {}
             Destination() {}
 
             Destination& operator=(const Destination& dest) {
                 ip = dest.ip;
                 port = dest.port;
+                addr = dest.addr;
                 is_multicast = dest.is_multicast;
+                fanout = dest.fanout;
+                invalidate();
                 return *this;
             }
             Destination& operator=(Destination&& dest) {
@@ -138,18 +232,139 @@ namespace osc {
                 port = std::move(dest.port);
                 addr = std::move(dest.addr);
                 is_multicast = std::move(dest.is_multicast);
+                fanout = dest.fanout;
+                invalidate();
                 return *this;
             }
             inline bool operator<(const Destination& rhs) const {
                 return (ip != rhs.ip) ? (ip < rhs.ip) : (port != rhs.port) ? (port < rhs.port)
-                                                                           : (addr < rhs.addr);
+                                                    : (addr != rhs.addr) ? (addr < rhs.addr)
+                                                                         : ((uintptr_t)fanout < (uintptr_t)rhs.fanout);
             }
             inline bool operator==(const Destination& rhs) const {
-                return (ip == rhs.ip) && (port == rhs.port) && (addr == rhs.addr) && (is_multicast == rhs.is_multicast);
+                return (ip == rhs.ip) && (port == rhs.port) && (addr == rhs.addr) && (is_multicast == rhs.is_multicast) && (fanout == rhs.fanout);
             }
             inline bool operator!=(const Destination& rhs) const {
                 return !(*this == rhs);
             }
+            // true if the packets to both destinations can be sent together
+            inline bool isSameHost(const Destination& rhs) const {
+                return (ip == rhs.ip) && (port == rhs.port) && (is_multicast == rhs.is_multicast) && (fanout == rhs.fanout);
+            }
+
+            // parses ip only once, returns false if it is not an ip address (e.g. host name)
+            bool resolve() const {
+                if (ip_state == IP_UNRESOLVED)
+                    ip_state = ip_addr.fromString(ip) ? IP_ADDRESS : IP_HOSTNAME;
+                return ip_state == IP_ADDRESS;
+            }
+
+            void invalidate() {
+                ip_state = IP_UNRESOLVED;
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+                header.clear();
+                header_tags = "";
+#endif
+            }
+        };
+
+        struct PublishEntry {
+            uint32_t deadline_us;
+            const Destination* dest;
+            const ElementRef* ref;
+        };
+
+        // publishers ordered by the next deadline in the min-heap, so that post() touches only the due ones
+        // deadlines are compared by the signed difference from micros(), so they must be within about 35 minutes
+        // the heap points into DestinationMap, and is rebuilt when a publisher is added or any interval is changed
+        class PublishQueue {
+            PublishHeap heap;
+            uint32_t revision {0};
+            bool is_dirty {true};
+
+        public:
+            static constexpr uint32_t NO_DEADLINE {0xFFFFFFFF};
+
+            void invalidate() { is_dirty = true; }
+            bool isOutdated() const { return is_dirty || (revision != element::Base::revision()); }
+
+            void rebuild(const DestinationMap& dest_map, const uint32_t now) {
+                heap.clear();
+                for (auto& mp : dest_map) {
+                    if (!mp.second) continue;
+                    const element::Base& e = *mp.second;
+                    PublishEntry entry;
+                    entry.deadline_us = e.next() ? now : (e.last_publish_us + e.currentIntervalUsec());
+                    entry.dest = &mp.first;
+                    entry.ref = &mp.second;
+                    heap.push_back(entry);
+                    siftUp(heap.size() - 1);
+                }
+                revision = element::Base::revision();
+                is_dirty = false;
+            }
+
+            // calls f(const Destination&, const ElementRef&) for every due publisher
+            // and returns microseconds until the next deadline (NO_DEADLINE if there is no publisher)
+            template <typename F>
+            uint32_t dispatchDue(const uint32_t now, F&& f) {
+                while (!heap.empty() && ((int32_t)(now - heap.front().deadline_us) >= 0)) {
+                    PublishEntry& entry = heap.front();
+                    element::Base& e = **entry.ref;
+                    f(*entry.dest, *entry.ref);
+                    e.last_publish_us = now;
+                    e.has_published = true;
+
+                    // keep the rate from the previous deadline, but restart from now if it is late more than one interval
+                    const uint32_t interval = e.currentIntervalUsec() ? e.currentIntervalUsec() : 1;
+                    uint32_t next = entry.deadline_us + interval;
+                    if ((int32_t)(now - next) >= 0) {
+#ifdef ARDUINOOSC_ENABLE_STATS
+                        if (e.currentIntervalUsec()) entry.dest->stats.missed_ticks += (now - entry.deadline_us) / interval;
+#endif
+                        next = now + interval;
+                    }
+                    entry.deadline_us = next;
+                    siftDown(0);
+                }
+                if (heap.empty()) return NO_DEADLINE;
+                return heap.front().deadline_us - now;
+            }
+
+            size_t size() const { return heap.size(); }
+            bool empty() const { return heap.empty(); }
+
+        private:
+            static bool earlier(const PublishEntry& a, const PublishEntry& b) {
+                return (int32_t)(a.deadline_us - b.deadline_us) < 0;
+            }
+
+            void siftUp(size_t i) {
+                while (i > 0) {
+                    const size_t parent = (i - 1) / 2;
+                    if (!earlier(heap[i], heap[parent])) break;
+                    const PublishEntry tmp = heap[i];
+                    heap[i] = heap[parent];
+                    heap[parent] = tmp;
+                    i = parent;
+                }
+            }
+
+            void siftDown(size_t i) {
+                const size_t sz = heap.size();
+                while (true) {
+                    const size_t l = 2 * i + 1;
+                    const size_t r = l + 1;
+                    size_t m = i;
+                    if ((l < sz) && earlier(heap[l], heap[m])) m = l;
+                    if ((r < sz) && earlier(heap[r], heap[m])) m = r;
+                    if (m == i) break;
+                    const PublishEntry tmp = heap[i];
+                    heap[i] = heap[m];
+                    heap[m] = tmp;
+                    i = m;
+                }
+            }
         };
 
         template <typename S>
@@ -157,63 +372,271 @@ namespace osc {
             Encoder writer;
             Message msg;
             uint16_t local_port;
+            mutable UdpRef<S> udp_ref;  // bound at the first use, and kept while local_port is not changed
+            uint8_t last_result {TX_OK};
+            IPAddress multicast_iface;          // set by multicastInterface()
+            mutable IPAddress default_iface;    // ARDUINOOSC_DEFAULT_MULTICAST_IFACE() cached once the link has it
+            reliable::Sender* reliable {nullptr};
+            StateCache* state {nullptr};
 
         public:
+            enum : uint8_t { TX_OK, TX_BEGIN_FAILED, TX_END_FAILED };
+
             Client(const uint16_t local_port = PORT_DISCARD)
             : local_port(local_port) {
             }
 
             void localPort(const uint16_t port) {
+                if (port != local_port) udp_ref = UdpRef<S>();
                 local_port = port;
             }
             uint16_t localPort() const {
-                return UdpMapManager<S>::getInstance().getUdp(local_port)->localPort();
+                S* stream = udp();
+                return stream ? stream->localPort() : 0;
             }
 
+            // result of the last packet (TX_OK, TX_BEGIN_FAILED or TX_END_FAILED)
+            // TX_BEGIN_FAILED also means that no udp could be bound to the local port
+            uint8_t lastResult() const { return last_result; }
+
+            // interface of the multicast packets, ARDUINOOSC_DEFAULT_MULTICAST_IFACE() is used if not set
+            // the default one is cached when it is not 0.0.0.0, set 0.0.0.0 to use the default one again
+            void multicastInterface(const IPAddress& iface) {
+                multicast_iface = iface;
+            }
+            const IPAddress& multicastInterface() const {
+                if ((uint32_t)multicast_iface != 0) return multicast_iface;
+                if ((uint32_t)default_iface == 0) default_iface = ARDUINOOSC_DEFAULT_MULTICAST_IFACE();
+                return default_iface;
+            }
+            // forget the cached default interface, it is looked up again at the next multicast packet
+            void linkChanged() {
+                default_iface = IPAddress();
+            }
+
+            // all send functions return false if the packet could not be sent (e.g. tx queue is full)
             template <typename... Rest>
-            void send(const String& ip, const uint16_t port, const String& addr, Rest&&... rest) {
+            bool send(const String& ip, const uint16_t port, const String& addr, Rest&&... rest) {
                 msg.init(addr);
-                send(ip, port, msg, std::forward<Rest>(rest)...);
+                return send(ip, port, msg, std::forward<Rest>(rest)...);
             }
             template <typename First, typename... Rest>
-            void send(const String& ip, const uint16_t port, Message& m, First&& first, Rest&&... rest) {
+            bool send(const String& ip, const uint16_t port, Message& m, First&& first, Rest&&... rest) {
                 m.push(first);
-                send(ip, port, m, std::forward<Rest>(rest)...);
+                return send(ip, port, m, std::forward<Rest>(rest)...);
             }
             
-            void send(const String& ip, const uint16_t port, Message& m) {
+            bool send(const String& ip, const uint16_t port, Message& m) {
+                if (reliable && reliable->isReliable(m.address())) return sendReliable(ip, port, m);
+                this->writer.init().encode(m);
+                remember(m.address(), 0);
+                return this->send(ip, port);
+            }
+
+            // messages to the addresses added to the sender are wrapped by send() into the envelope
+            // with the sequence number, and kept until they are acknowledged (see reliable::Sender)
+            // the sender must be valid while the client is running, pass nullptr to stop it
+            void useReliable(reliable::Sender* s) { reliable = s; }
+            reliable::Sender* getReliable() const { return reliable; }
+
+            // send the message in the envelope regardless of its address
+            // it is sent as best effort if the ip is not an ip address, the envelope is too large,
+            // or all the destinations of the sender have pending packets
+            bool sendReliable(const String& ip, const uint16_t port, Message& m) {
+                IPAddress addr;
+                if (!reliable || !addr.fromString(ip)) {
+                    LOG_ERROR(F("reliable message needs the sender and an ip address:"), ip);
+                    this->writer.init().encode(m);
+                    remember(m.address(), 0);
+                    return this->send(ip, port);
+                }
+                this->writer.init().encode(m);
+                remember(m.address(), 0);
+                // m may be msg itself, but it is not used after encoded
+                const uint32_t seq = reliable->wrap(msg, addr, port, this->writer.data(), this->writer.size());
+                if (seq == 0) return this->send(ip, port);
+                this->writer.init().encode(msg);
+                reliable->hold(seq, addr, port, this->writer.data(), this->writer.size());
+                S* stream = udp();
+                if (!stream) return noSocket();
+                return transmit(*stream, stream->beginPacket(addr, port), this->writer.data(), this->writer.size());
+            }
+
+            // resend the reliable messages whose ACK is timed out or which are reported as lost
+            // called by client::Manager::post(), returns the number of the resent packets
+            size_t retransmit() {
+                if (!reliable) return 0;
+                return reliable->retransmitDue([&](const IPAddress& ip, const uint16_t port, const uint8_t* data, const size_t size) {
+                    S* stream = udp();
+                    if (!stream) return noSocket();
+                    return transmit(*stream, stream->beginPacket(ip, port), data, size);
+                });
+            }
+
+            // keep the latest encoded message of every address sent by this client, pass nullptr to stop it
+            // the cache must be valid while the client is running
+            void useStateCache(StateCache* c) { state = c; }
+            StateCache* getStateCache() const { return state; }
+
+            // send the cached messages whose address starts with prefix, packed in the bundles up to mtu bytes
+            // a message larger than the bundle is sent alone, returns the number of the sent packets
+            size_t sendState(const IPAddress& ip, const uint16_t port, const StateCache& cache, const String& prefix = "", const size_t mtu = ARDUINOOSC_PUBLISH_BATCH_MTU) {
+                size_t n = 0;
+                S* stream = udp();
+                if (!stream) return noSocket();
+#ifndef ARDUINOOSC_DISABLE_BUNDLE
+                static constexpr size_t BUNDLE_HEADER_SIZE {16};
+                size_t num_in_bundle = 0;
+                writer.init().begin_bundle();
+                for (const auto& e : cache.getEntries()) {
+                    if (!e.address.startsWith(prefix)) continue;
+                    const uint8_t* data = (const uint8_t*)e.data.data();
+                    if (BUNDLE_HEADER_SIZE + 4 + e.data.size() > mtu) {
+                        if (transmit(*stream, stream->beginPacket(ip, port), data, e.data.size())) ++n;
+                        continue;
+                    }
+                    if (num_in_bundle && (writer.size() + 4 + e.data.size() > mtu)) {
+                        writer.end_bundle();
+                        if (transmit(*stream, stream->beginPacket(ip, port), writer.data(), writer.size())) ++n;
+                        writer.init().begin_bundle();
+                        num_in_bundle = 0;
+                    }
+                    writer.encode(data, e.data.size());
+                    ++num_in_bundle;
+                }
+                if (num_in_bundle) {
+                    writer.end_bundle();
+                    if (transmit(*stream, stream->beginPacket(ip, port), writer.data(), writer.size())) ++n;
+                }
+#else
+                (void)mtu;
+                for (const auto& e : cache.getEntries()) {
+                    if (!e.address.startsWith(prefix)) continue;
+                    if (transmit(*stream, stream->beginPacket(ip, port), (const uint8_t*)e.data.data(), e.data.size())) ++n;
+                }
+#endif
+                return n;
+            }
+
+            // send the message to the ip address without resolving it (e.g. the reply to the sender)
+            bool sendTo(const IPAddress& ip, const uint16_t port, Message& m) {
                 this->writer.init().encode(m);
-                this->send(ip, port);
+                S* stream = udp();
+                if (!stream) return noSocket();
+                return transmit(*stream, stream->beginPacket(ip, port), this->writer.data(), this->writer.size());
             }
 
-            void send(const String &ip, const uint16_t port)
+            // only the arguments are encoded into the packet of the schema
+            template <typename... Ts, typename... Args>
+            bool send(const String& ip, const uint16_t port, Schema<Ts...>& schema, const Args&... args) {
+                schema.encode(args...);
+                if (state) state->update(schema.address(), schema.data(), schema.size());
+                S* stream = udp();
+                if (!stream) return noSocket();
+                return transmit(*stream, stream->beginPacket(ip.c_str(), port), schema.data(), schema.size());
+            }
+
+            bool send(const String &ip, const uint16_t port)
             {
-                auto stream = UdpMapManager<S>::getInstance().getUdp(local_port);
-                stream->beginPacket(ip.c_str(), port);
-                stream->write(this->writer.data(), this->writer.size());
-                stream->endPacket();
+                S* stream = udp();
+                if (!stream) return noSocket();
+                return transmit(*stream, stream->beginPacket(ip.c_str(), port), this->writer.data(), this->writer.size());
+            }
+
+            // send encoded data to the cached ip address of the destination
+            bool send(const Destination& dest)
+            {
+                if (!dest.resolve()) return send(dest.ip, dest.port);
+                S* stream = udp();
+                if (!stream) return noSocket();
+                return transmit(*stream, stream->beginPacket(dest.ip_addr, dest.port), this->writer.data(), this->writer.size());
+            }
+
+            // send all chunks of the current transfer of the chunker, returns false if any of them failed
+            bool sendBlob(const String& ip, const uint16_t port, blob::Chunker& chunker) {
+                bool b = (chunker.numChunks() != 0);
+                for (size_t i = 0; i < chunker.numChunks(); ++i)
+                    b &= sendBlobChunk(ip, port, chunker, i);
+                return b;
+            }
+
+            // send (or resend) one chunk, e.g. the one reported as missing by the receiver
+            // the chunk data is written to udp directly from the buffer of the chunker
+            bool sendBlobChunk(const String& ip, const uint16_t port, blob::Chunker& chunker, const size_t i) {
+                if (i >= chunker.numChunks()) return false;
+                static const uint8_t zeros[4] {0};
+                S* stream = udp();
+                if (!stream) return noSocket();
+                if (!stream->beginPacket(ip.c_str(), port)) {
+                    last_result = TX_BEGIN_FAILED;
+                    return false;
+                }
+                const size_t size = chunker.encodedSize(i);
+                size_t written = stream->write(chunker.header(), chunker.headerSize());
+                written += stream->write(chunker.prefix(i), chunker.prefixSize());
+                if (chunker.payloadSize(i)) written += stream->write(chunker.payload(i), chunker.payloadSize(i));
+                if (chunker.padding(i)) written += stream->write(zeros, chunker.padding(i));
+                const int ended = stream->endPacket();
+                last_result = ((written == size) && ended) ? TX_OK : TX_END_FAILED;
+                return last_result == TX_OK;
             }
 
-            void sendMulticast(const String& ip, const uint16_t port, Message& m)
+            bool sendMulticast(const String& ip, const uint16_t port, Message& m)
             {
                 this->writer.init().encode(m);
-                this->sendMulticast(ip, port);
+                remember(m.address(), 0);
+                return this->sendMulticast(ip, port);
             }
 
-            void sendMulticast(const String &ip, const uint16_t port)
+            bool sendMulticast(const String &ip, const uint16_t port)
             {
-                auto stream = UdpMapManager<S>::getInstance().getUdp(local_port);
+                S* stream = udp();
+                if (!stream) return noSocket();
                 IPAddress ipaddr;
                 ipaddr.fromString(ip);
 
-                stream->beginPacketMulticast(ipaddr, port, WiFi.localIP());
-                stream->write(this->writer.data(), this->writer.size());
-                stream->endPacket();
+                return transmit(*stream, stream->beginPacketMulticast(ipaddr, port, multicastInterface()), this->writer.data(), this->writer.size());
 
                 //LOG.verbose("Sending data %s with size %d", this->writer.data(), this->writer.size());
                 //LOG.verbose("Remote Addr %s:%d local iface %s  <-", ipaddr.toString(), port, iff.toString());
             }
 
+            bool sendMulticast(const Destination& dest)
+            {
+                dest.resolve();
+                S* stream = udp();
+                if (!stream) return noSocket();
+                return transmit(*stream, stream->beginPacketMulticast(dest.ip_addr, dest.port, multicastInterface()), this->writer.data(), this->writer.size());
+            }
+
+            // fan-out: the message is encoded once and sent to every endpoint of the group
+            // returns false if any of them failed, the results of each endpoint are counted in it
+            template <typename... Rest>
+            bool send(const Fanout& group, const String& addr, Rest&&... rest) {
+                msg.init(addr);
+                return send(group, msg, std::forward<Rest>(rest)...);
+            }
+            template <typename First, typename... Rest>
+            bool send(const Fanout& group, Message& m, First&& first, Rest&&... rest) {
+                m.push(first);
+                return send(group, m, std::forward<Rest>(rest)...);
+            }
+            bool send(const Fanout& group, Message& m) {
+                this->writer.init().encode(m);
+                remember(m.address(), 0);
+                return this->send(group);
+            }
+            template <typename... Ts, typename... Args>
+            bool send(const Fanout& group, Schema<Ts...>& schema, const Args&... args) {
+                schema.encode(args...);
+                if (state) state->update(schema.address(), schema.data(), schema.size());
+                return fanout(group, schema.data(), schema.size());
+            }
+            // send encoded data (e.g. the bundle) to every endpoint of the group
+            bool send(const Fanout& group) {
+                return fanout(group, this->writer.data(), this->writer.size());
+            }
+
 #ifndef ARDUINOOSC_DISABLE_BUNDLE
 
             void begin_bundle(const TimeTag &tt) {
@@ -232,7 +655,9 @@ namespace osc {
             }
             void add_bundle(Message& m)
             {
+                const size_t pos = this->writer.size();
                 this->writer.encode(m);
+                remember(m.address(), pos + 4);
             }
             void end_bundle()
             {
@@ -241,28 +666,209 @@ namespace osc {
 
 #endif // ARDUINOOSC_DISABLE_BUNDLE
 
-            void send(const Destination& dest, ElementRef elem) {
-                elem->init(msg, dest.addr);
-                elem->encodeTo(msg);
-                send(dest.ip, dest.port, msg);
+            // the publisher in the change-driven mode is not sent if its payload is not changed
+            bool send(const Destination& dest, const ElementRef& elem) {
+                const size_t sz = prepare(dest, elem);
+                const uint32_t begin_us = micros();
+                if (!elem->isChanged(msg, begin_us)) return true;
+                writer.init();
+                encodePrepared(dest);
+                remember(dest.addr, 0);
+                const bool b = sendEncoded(dest);
+                elem->onSent(b, micros() - begin_us);
+#ifdef ARDUINOOSC_ENABLE_STATS
+                onSent(dest, sz);
+#else
+                (void)sz;
+#endif
+                return b;
             }
 
-            void sendMulticast(const Destination& dest, ElementRef elem) 
+            bool sendMulticast(const Destination& dest, const ElementRef& elem)
             {
+                return send(dest, elem);
+            }
+
+#ifndef ARDUINOOSC_DISABLE_BUNDLE
+
+            // sends the publishers in the batch which have the same host as batch[first] in the bundles,
+            // and the sent entries are cleared. the bundle is split before it exceeds max_size bytes
+            // returns false if any bundle could not be sent
+            bool sendBatch(PublishBatch& batch, const size_t first, const size_t max_size) {
+                const Destination& head = *batch[first].dest;
+                size_t num_in_bundle = 0;
+                size_t bundle_first = first;
+                bool b = true;
+                writer.init().begin_bundle();
+                for (size_t i = first; i < batch.size(); ++i) {
+                    const Destination* dest = batch[i].dest;
+                    if (!dest || !dest->isSameHost(head)) continue;
+                    const size_t sz = prepare(*dest, *batch[i].ref);
+                    if (!(*batch[i].ref)->isChanged(msg, micros())) {
+                        batch[i].dest = nullptr;
+                        continue;
+                    }
+                    if (num_in_bundle && (writer.size() + 4 + sz > max_size)) {
+                        b &= sendBundle(head, batch, bundle_first, i);
+                        writer.init().begin_bundle();
+                        num_in_bundle = 0;
+                        bundle_first = i;
+                    }
+                    const size_t pos = writer.size();
+                    encodePrepared(*dest);
+                    remember(dest->addr, pos + 4);
+#ifdef ARDUINOOSC_ENABLE_STATS
+                    dest->stats.bytes += sz;
+#endif
+                    ++num_in_bundle;
+                }
+                if (num_in_bundle) b &= sendBundle(head, batch, bundle_first, batch.size());
+                return b;
+            }
+
+#endif // ARDUINOOSC_DISABLE_BUNDLE
+
+        private:
+            // cache the message encoded at pos of the writer (after the size in the bundle)
+            void remember(const String& addr, const size_t pos) {
+                if (!state || writer.overflow() || (writer.size() < pos)) return;
+                state->update(addr, writer.data() + pos, writer.size() - pos);
+            }
+
+            // nullptr if no more udp can be bound (too many ports on NO-STL boards)
+            S* udp() const {
+                if (!udp_ref) udp_ref = UdpMapManager<S>::getInstance().getUdp(local_port);
+                return udp_ref.get();
+            }
+            bool noSocket() {
+                last_result = TX_BEGIN_FAILED;
+                return false;
+            }
+
+            // send encoded data to the group, the multicast group or the host of the destination
+            bool sendEncoded(const Destination& dest) {
+                if (dest.fanout) return send(*dest.fanout);
+                return dest.is_multicast ? sendMulticast(dest) : send(dest);
+            }
+
+            template <typename Data>
+            bool fanout(const Fanout& group, const Data* data, const size_t size) {
+                S* stream = udp();
+                bool b = true;
+                for (const auto& e : group.getEndpoints()) {
+                    if (!stream) {
+                        ++e.failures;
+                        b = noSocket();
+                        continue;
+                    }
+                    const int began = e.is_multicast
+                        ? stream->beginPacketMulticast(e.ip, e.port, (uint32_t)e.iface ? e.iface : multicastInterface())
+                        : stream->beginPacket(e.ip, e.port);
+                    if (transmit(*stream, began, data, size)) {
+                        ++e.sent;
+                    } else {
+                        ++e.failures;
+                        b = false;
+                    }
+                }
+                return b;
+            }
+
+            template <typename Data>
+            bool transmit(S& stream, const int began, const Data* data, const size_t size) {
+                if (!began) {
+                    last_result = TX_BEGIN_FAILED;
+                    return false;
+                }
+                const size_t written = stream.write(data, size);
+                const int ended = stream.endPacket();
+                last_result = ((written == size) && ended) ? TX_OK : TX_END_FAILED;
+                return last_result == TX_OK;
+            }
+
+#ifdef ARDUINOOSC_ENABLE_STATS
+            void onAttempt(const Destination& dest) {
+                DestinationStats& st = dest.stats;
+                const uint32_t now = micros();
+                if (st.attempts == 0) st.first_us = now;
+                st.last_us = now;
+                ++st.attempts;
+                if (last_result == TX_BEGIN_FAILED) ++st.begin_failures;
+                else if (last_result == TX_END_FAILED) ++st.end_failures;
+            }
+            void onSent(const Destination& dest, const size_t sz) {
+                dest.stats.bytes += sz;
+                onAttempt(dest);
+            }
+#endif
+
+            // pushes the arguments of the publisher to msg and returns the encoded size
+            // the header of the destination is encoded again only when the type tags are changed
+            size_t prepare(const Destination& dest, const ElementRef& elem) {
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+                msg.clearArguments();
+                elem->encodeTo(msg);
+                if (dest.header.empty() || (dest.header_tags != msg.typeTags())) {
+                    Storage s;
+                    Message::encodeHeader(s, dest.addr, msg.typeTags());
+                    dest.header.assign(s.begin(), s.end());
+                    dest.header_tags = msg.typeTags();
+                }
+                return dest.header.size() + msg.argumentsSize();
+#else
                 elem->init(msg, dest.addr);
                 elem->encodeTo(msg);
-                sendMulticast(dest.ip, dest.port, msg);
+                return msg.encodedSize();
+#endif
             }
+
+            void encodePrepared(const Destination& dest) {
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+                writer.encode(dest.header, msg);
+#else
+                (void)dest;
+                writer.encode(msg);
+#endif
+            }
+
+#ifndef ARDUINOOSC_DISABLE_BUNDLE
+            // sends the bundle and clears the entries of the host in batch[first, last)
+            bool sendBundle(const Destination& head, PublishBatch& batch, const size_t first, const size_t last) {
+                writer.end_bundle();
+                const uint32_t begin_us = micros();
+                const bool b = sendEncoded(head);
+                const uint32_t elapsed_us = micros() - begin_us;
+                for (size_t i = first; i < last; ++i) {
+                    const Destination* dest = batch[i].dest;
+                    if (!dest || !dest->isSameHost(head)) continue;
+                    (*batch[i].ref)->onSent(b, elapsed_us);
+#ifdef ARDUINOOSC_ENABLE_STATS
+                    onAttempt(*dest);
+#endif
+                    batch[i].dest = nullptr;
+                }
+                return b;
+            }
+#endif // ARDUINOOSC_DISABLE_BUNDLE
         };
 
         template <typename S>
         class Manager {
-            Manager() {}
+            Manager() {
+                ARDUINOOSC_ON_LINK_CHANGE(onLinkChanged);
+            }
             Manager(const Manager&) = delete;
             Manager& operator=(const Manager&) = delete;
 
             Client<S> client;
             DestinationMap dest_map;
+            PublishQueue publish_queue;
+#ifndef ARDUINOOSC_DISABLE_BUNDLE
+            PublishBatch batch;
+            size_t batch_mtu {ARDUINOOSC_PUBLISH_BATCH_MTU};
+            bool use_batching {false};
+#endif
+            StateCache state_cache;
 
         public:
             static Manager<S>& getInstance() {
@@ -274,6 +880,14 @@ namespace osc {
                 return client;
             }
 
+            // call it after the link is reconnected or its address is changed (done by the event on ESP32)
+            void linkChanged() {
+                client.linkChanged();
+            }
+            static void onLinkChanged() {
+                getInstance().linkChanged();
+            }
+
             void localPort(const uint16_t port) {
                 client.localPort(port);
             }
@@ -282,8 +896,23 @@ namespace osc {
             }
 
             template <typename... Ts>
-            void send(const String& ip, const uint16_t port, const String& addr, Ts&&... ts) {
-                client.send(ip, port, addr, std::forward<Ts>(ts)...);
+            bool send(const String& ip, const uint16_t port, const String& addr, Ts&&... ts) {
+                return client.send(ip, port, addr, std::forward<Ts>(ts)...);
+            }
+            template <typename... Ts, typename... Args>
+            bool send(const String& ip, const uint16_t port, Schema<Ts...>& schema, const Args&... args) {
+                return client.send(ip, port, schema, args...);
+            }
+            bool sendBlob(const String& ip, const uint16_t port, blob::Chunker& chunker) {
+                return client.sendBlob(ip, port, chunker);
+            }
+            template <typename... Ts>
+            bool send(const Fanout& group, const String& addr, Ts&&... ts) {
+                return client.send(group, addr, std::forward<Ts>(ts)...);
+            }
+            template <typename... Ts, typename... Args>
+            bool send(const Fanout& group, Schema<Ts...>& schema, const Args&... args) {
+                return client.send(group, schema, args...);
             }
 
             void begin_bundle(const TimeTag &tt) {
@@ -296,20 +925,74 @@ namespace osc {
             void end_bundle() {
                 client.end_bundle();
             }
-            void send_bundle(const String& ip, const uint16_t port) {
-                client.send(ip, port);
+            bool send_bundle(const String& ip, const uint16_t port) {
+                return client.send(ip, port);
+            }
+            bool send_bundle(const Fanout& group) {
+                return client.send(group);
             }
 
-            void post() {
-                for (auto& mp : dest_map) {
-                    if (mp.second->next()) {
-                        mp.second->last_publish_us = micros();
-                        if(mp.first.is_multicast)
-                            client.sendMulticast(mp.first, mp.second);
-                        else
-                            client.send(mp.first, mp.second);
-                    }
+            // publish only the due publishers, and returns microseconds until the next one is due
+            // (PublishQueue::NO_DEADLINE if nothing is published)
+            // the reliable messages which are not acknowledged in time are resent before them
+            uint32_t post() {
+                client.retransmit();
+                const uint32_t now = micros();
+                if (publish_queue.isOutdated()) publish_queue.rebuild(dest_map, now);
+#ifndef ARDUINOOSC_DISABLE_BUNDLE
+                if (use_batching) {
+                    batch.clear();
+                    const uint32_t wait_us = publish_queue.dispatchDue(now, [&](const Destination& dest, const ElementRef& ref) {
+                        PublishEntry entry;
+                        entry.deadline_us = now;
+                        entry.dest = &dest;
+                        entry.ref = &ref;
+                        batch.push_back(entry);
+                    });
+                    postBatch();
+                    return wait_us;
                 }
+#endif
+                return publish_queue.dispatchDue(now, [&](const Destination& dest, const ElementRef& ref) {
+                    client.send(dest, ref);
+                });
+            }
+
+#ifndef ARDUINOOSC_DISABLE_BUNDLE
+
+            // due publishers which have the same ip and port are sent together in the bundles up to mtu bytes
+            void usePublishBatching(const bool b, const size_t mtu = ARDUINOOSC_PUBLISH_BATCH_MTU) {
+                use_batching = b;
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+                batch_mtu = mtu;
+#else
+                batch_mtu = (mtu > ARDUINOOSC_MAX_MSG_BYTE_SIZE) ? ARDUINOOSC_MAX_MSG_BYTE_SIZE : mtu;
+#endif
+            }
+            bool isPublishBatchingUsed() const { return use_batching; }
+
+#endif // ARDUINOOSC_DISABLE_BUNDLE
+
+            // keep the latest encoded message of every address sent or published, for the late-joining peers
+            // the bytes encoded for each send are copied, so the publish rates are not changed
+            void useStateCache(const bool b) {
+                client.useStateCache(b ? &state_cache : nullptr);
+                if (!b) state_cache.clear();
+            }
+            bool isStateCacheUsed() const { return client.getStateCache() != nullptr; }
+            const StateCache& getStateCache() const { return state_cache; }
+
+            // reply the cache to the request /state/dump [int32 reply port] [string address prefix]
+            // the reply goes to the remote port of the request if the reply port is not given
+            size_t dumpState(const Message& req) {
+                if (!isStateCacheUsed()) return 0;
+                const uint16_t port = ((req.size() > 0) && req.isInt32(0)) ? (uint16_t)req.getArgAsInt32(0) : req.remotePort();
+                const String prefix = ((req.size() > 1) && req.isStr(1)) ? req.getArgAsString(1) : String("");
+#ifndef ARDUINOOSC_DISABLE_BUNDLE
+                return client.sendState(req.remoteAddress(), port, state_cache, prefix, batch_mtu);
+#else
+                return client.sendState(req.remoteAddress(), port, state_cache, prefix);
+#endif
             }
 
             ElementRef publish(const String& ip, const uint16_t port, const String& addr, const char* const value) {
@@ -349,23 +1032,79 @@ namespace osc {
                 return publish_impl(ip, port, addr, make_element_ref(v));
             }
 
+            // fan-out publisher: the value is encoded once per tick and sent to every endpoint of the group
+            template <typename T>
+            ElementRef publish(const Fanout& group, const String& addr, T&& value) {
+                return publish_impl(Destination(group, addr), make_element_ref(std::forward<T>(value)));
+            }
+            template <typename T, typename U, typename... Ts>
+            ElementRef publish(const Fanout& group, const String& addr, T&& t, U&& u, Ts&&... ts) {
+                ElementTupleRef v {make_element_ref(std::forward<T>(t)), make_element_ref(std::forward<U>(u)), make_element_ref(std::forward<Ts>(ts))...};
+                return publish_impl(Destination(group, addr), make_element_ref(v));
+            }
+
             ElementRef getPublishElementRef(const String& ip, const uint16_t port, const String& addr) {
+                return getPublishElementRef(Destination(ip, port, addr));
+            }
+            ElementRef getPublishElementRef(const Fanout& group, const String& addr) {
+                return getPublishElementRef(Destination(group, addr));
+            }
+
+#ifdef ARDUINOOSC_ENABLE_STATS
+            // nullptr if the destination is not published
+            const DestinationStats* getPublishStats(const String& ip, const uint16_t port, const String& addr) const {
                 Destination dest {ip, port, addr};
-                return dest_map[dest];
+                auto it = dest_map.find(dest);
+                return (it != dest_map.end()) ? &it->first.stats : nullptr;
+            }
+            void resetPublishStats() {
+                for (auto& mp : dest_map) mp.first.stats.reset();
             }
+#endif
 
         private:
+#ifndef ARDUINOOSC_DISABLE_BUNDLE
+            void postBatch() {
+                for (size_t i = 0; i < batch.size(); ++i) {
+                    const Destination* dest = batch[i].dest;
+                    if (!dest) continue;
+                    size_t n = 0;
+                    for (size_t j = i; j < batch.size(); ++j)
+                        if (batch[j].dest && batch[j].dest->isSameHost(*dest)) ++n;
+                    if (n > 1) {
+                        client.sendBatch(batch, i, batch_mtu);
+                    } else {
+                        client.send(*dest, *batch[i].ref);
+                    }
+                }
+                batch.clear();
+            }
+#endif
+
             ElementRef publish_impl(const String& ip, const uint16_t port, const String& addr, ElementRef ref) {
-                Destination dest {ip, port, addr};
-                dest_map.insert(std::make_pair(dest, ref));
-                return ref;
+                return publish_impl(Destination(ip, port, addr), ref);
             }
 
             ElementRef publish_impl_multicast(const String& ip, const uint16_t port, const String& addr, ElementRef ref) {
-                Destination dest(ip, port, addr, true);
+                return publish_impl(Destination(ip, port, addr, true), ref);
+            }
+
+            ElementRef publish_impl(const Destination& dest, ElementRef ref) {
+#if ARX_HAVE_LIBSTDCPLUSPLUS < 201103L  // Don't have libstdc++11
+                if ((dest_map.size() >= ARDUINOOSC_MAX_PUBLISH_DESTINATION) && (dest_map.find(dest) == dest_map.end())) {
+                    LOG_ERROR(F("too many publishers, max is"), ARDUINOOSC_MAX_PUBLISH_DESTINATION, F(", not published:"), dest.addr);
+                    return ref;
+                }
+#endif
                 dest_map.insert(std::make_pair(dest, ref));
+                publish_queue.invalidate();
                 return ref;
             }
+
+            ElementRef getPublishElementRef(const Destination& dest) {
+                auto it = dest_map.find(dest);
+                return (it != dest_map.end()) ? it->second : ElementRef();
+            }
         };
 
     }  // namespace client
@@ -377,5 +1116,6 @@ using OscClient = arduino::osc::client::Client<S>;
 template <typename S>
 using OscClientManager = arduino::osc::client::Manager<S>;
 using OscPublishElementRef = arduino::osc::client::ElementRef;
+using OscPublishQueue = arduino::osc::client::PublishQueue;
 
 #endif  // ARDUINOOSC_OSCCLIENT_H
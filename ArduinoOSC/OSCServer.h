@@ -12,7 +12,16 @@
 
 #include "OscMessage.h"
 #include "OscDecoder.h"
+#include "OscSchema.h"
+#include "OscDispatcher.h"
+#include "OscRxBuffer.h"
+#include "OscScheduler.h"
+#include "OscCoalescer.h"
+#include "OscBlob.h"
 #include "OscUdpMap.h"
+#include "OscStats.h"
+#include "OscWorker.h"
+#include "OscReliable.h"
 
 namespace arduino {
 namespace osc {
@@ -21,17 +30,19 @@ namespace osc {
         using namespace message;
 
         namespace element {
-            struct Base {
+            struct Base : public RefCounted, public ArenaAllocated {
                 virtual ~Base() {}
                 virtual void decodeFrom(Message& m, const size_t offset = 0) = 0;
+                virtual void decodeFrom(const MessageView& m, const size_t offset = 0) = 0;
             };
 
-            template <typename T>
-            inline void decode_from_msg(Message& m, const size_t i, T& t) {
-                t = m.arg<T>(i);
+            template <typename M, typename T>
+            inline void decode_from_msg(const M& m, const size_t i, T& t) {
+                t = m.template arg<T>(i);
             }
 
-            inline void decode_from_msg(Message& m, const TupleRef& ts) {
+            template <typename M>
+            inline void decode_from_msg(M& m, const TupleRef& ts) {
                 for (size_t idx = 0; idx < ts.size(); ++idx)
                     ts[idx]->decodeFrom(m, idx);
             }
@@ -48,6 +59,9 @@ namespace osc {
                 virtual void decodeFrom(Message& m, const size_t offset = 0) override {
                     decode_from_msg(m, offset, t);
                 }
+                virtual void decodeFrom(const MessageView& m, const size_t offset = 0) override {
+                    decode_from_msg(m, offset, t);
+                }
             };
 
             // mutiple values
@@ -59,6 +73,15 @@ namespace osc {
                 : t(std::move(t)) {}
                 virtual ~Tuple() {}
                 virtual void decodeFrom(Message& m, const size_t offset = 0) override {
+                    decode(m, offset);
+                }
+                virtual void decodeFrom(const MessageView& m, const size_t offset = 0) override {
+                    decode(m, offset);
+                }
+
+            private:
+                template <typename M>
+                void decode(M& m, const size_t offset) {
                     (void)offset;
                     if (m.size() == t.size()) {
                         decode_from_msg(m, t);
@@ -69,17 +92,17 @@ namespace osc {
             };
 
             namespace detail {
-                template <typename... Ts, size_t... Indices>
+                template <typename M, typename... Ts, size_t... Indices>
                 inline void read_to_tuple(
                     std::index_sequence<Indices...>&&,
-                    Message& m,
+                    const M& m,
                     std::tuple<Ts...>& t) {
                     size_t o {0};
                     dummy_vector_t {(decode_from_msg(m, o, std::get<Indices>(t)), ++o)...};
                 }
 
-                template <typename... Ts>
-                inline void read_to_tuple(Message& m, std::tuple<Ts...>& t) {
+                template <typename M, typename... Ts>
+                inline void read_to_tuple(const M& m, std::tuple<Ts...>& t) {
                     read_to_tuple(std::index_sequence_for<Ts...>(), m, t);
                 }
             };  // namespace detail
@@ -95,11 +118,21 @@ namespace osc {
                 : func(func) {};
                 virtual ~Function() {}
                 virtual void decodeFrom(Message& m, size_t offset = 0) override {
+                    decode(m);
+                    (void)offset;
+                }
+                virtual void decodeFrom(const MessageView& m, size_t offset = 0) override {
+                    decode(m);
+                    (void)offset;
+                }
+
+            private:
+                template <typename M>
+                void decode(const M& m) {
                     if (m.size() == sizeof...(Ts)) {
                         std::tuple<std::remove_cvref_t<Ts>...> t;
                         detail::read_to_tuple(m, t);
                         std::apply(func, t);
-                        (void)offset;
                     } else {
                         LOG_ERROR("arg size mismatch: msg", m.size(), "/ func", sizeof...(Ts));
                     }
@@ -120,6 +153,12 @@ namespace osc {
                     func(m);
                     (void)offset;
                 }
+                // Message is built only for this callback
+                virtual void decodeFrom(const MessageView& m, size_t offset = 0) override {
+                    Message msg = m.toMessage();
+                    func(msg);
+                    (void)offset;
+                }
             };
 
             // callback with const Message&
@@ -136,8 +175,106 @@ namespace osc {
                     func(m);
                     (void)offset;
                 }
+                // Message is built only for this callback
+                virtual void decodeFrom(const MessageView& m, size_t offset = 0) override {
+                    func(m.toMessage());
+                    (void)offset;
+                }
+            };
+
+            // callback with const MessageView&
+            template <typename R>
+            class Function<R, const MessageView&> : public Base {
+                using Func = std::function<R(const MessageView&)>;
+                Func func;
+
+            public:
+                Function(Func func)
+                : func(func) {};
+                virtual ~Function() {}
+                // the message is re-encoded to be viewed
+                virtual void decodeFrom(Message& m, size_t offset = 0) override {
+                    Storage s;
+                    m.encode(s);
+                    MessageView v(s.begin(), s.size(), m.timeTag());
+                    v.remoteIP(m.remoteAddress());
+                    v.remotePort(m.remotePort());
+                    func(v);
+                    (void)offset;
+                }
+                virtual void decodeFrom(const MessageView& m, size_t offset = 0) override {
+                    func(m);
+                    (void)offset;
+                }
+            };
+
+            // callback with fixed size arguments, which is called directly without std::function
+            // type tags are checked at once and the arguments are read from the payload without index checks
+            template <typename Func, typename R, typename... Ts>
+            class TypedFunction : public Base {
+                Func func;
+
+            public:
+                TypedFunction(const Func& func)
+                : func(func) {};
+                virtual ~TypedFunction() {}
+                virtual void decodeFrom(Message& m, size_t offset = 0) override {
+                    decode(m);
+                    (void)offset;
+                }
+                virtual void decodeFrom(const MessageView& m, size_t offset = 0) override {
+                    decode(m);
+                    (void)offset;
+                }
+
+            private:
+                template <typename M>
+                void decode(const M& m) {
+                    if (Schema<Ts...>::match(m)) {
+                        invoke(std::index_sequence_for<Ts...>(), m.argumentsData());
+                    } else {
+                        LOG_ERROR(F("type tags mismatch: msg"), m.typeTags(), F("/ func"), Schema<Ts...>::typeTags());
+                    }
+                }
+
+                template <size_t... Is>
+                void invoke(std::index_sequence<Is...>&&, const char* p) {
+                    func((std::remove_cvref_t<Ts>)bytes2pod<schema::wire_t<Ts>>(p + schema::offset_of<Is, Ts...>::value)...);
+                }
+            };
+
+            // chunks of the blob are copied into the buffer of the reassembler
+            class BlobChunk : public Base {
+                blob::Reassembler& r;
+
+            public:
+                BlobChunk(blob::Reassembler& r)
+                : r(r) {}
+                virtual ~BlobChunk() {}
+                virtual void decodeFrom(Message& m, const size_t offset = 0) override {
+                    r.feed(m);
+                    (void)offset;
+                }
+                virtual void decodeFrom(const MessageView& m, const size_t offset = 0) override {
+                    r.feed(m);
+                    (void)offset;
+                }
             };
 
+            namespace detail {
+                template <typename Func, typename Sig>
+                struct typed_function;
+                template <typename Func, typename R, typename... Ts>
+                struct typed_function<Func, std::function<R(Ts...)>> {
+                    using type = TypedFunction<Func, R, Ts...>;
+                };
+
+                // argument types are deduced from the signature of the function pointer or the lambda
+                template <typename F, typename D = std::decay_t<F>>
+                using typed_function_t = typename typed_function<D,
+                    typename arx::function_traits<std::conditional_t<std::is_pointer<D>::value, std::remove_pointer_t<D>, D>>::function>::type;
+            }  // namespace detail
+
         }  // namespace element
 
         // one (or last) argument
@@ -181,15 +318,39 @@ namespace osc {
             return make_element_ref(arx::function_traits<F>::cast(value));
         }
 
+        template <typename S>
+        class Manager;
+
         template <typename S>
         class Server {
+            friend class Manager<S>;
+
             Decoder decoder;
-            CallbackMap callbacks;
+            ViewDecoder view_decoder;
+            Dispatcher callbacks;
+            Scheduler scheduler;
+            Coalescer coalescer;
             const uint16_t port;
             OscMessage* msg_ptr {nullptr};
+            bool use_message_view = false;
+            bool use_scheduler = false;
             bool is_multicast = false;
+            bool in_pass = false;  // coalesced messages are dispatched at the end of the pass
             IPAddress multicast {0};
             IPAddress iface {0};
+            UdpRef<S> stream;  // bound at the first parse(), not at construction (WiFi may not be connected yet)
+            bool is_unbound {false};  // no udp can be bound to the port (too many ports on NO-STL boards)
+            uint32_t num_dropped {0};
+            reliable::Receiver* reliable_rx {nullptr};
+#ifdef ARDUINOOSC_ENABLE_STATS
+            ServerStats server_stats;
+            uint32_t rx_begin_us {0};
+            bool is_receiving {false};
+#endif
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+            DispatchWorker* workers {nullptr};
+            size_t num_workers {0};
+#endif
 
         public:
             explicit Server(const uint16_t port)
@@ -214,39 +375,374 @@ namespace osc {
             template <typename... Ts>
             void subscribe(const String& addr, Ts&&... ts) {
                 ElementRef ref = make_element_ref(std::forward<Ts>(ts)...);
-                callbacks.insert({addr, ref});
+                callbacks.insert(addr, ref);
+            }
+
+            // callback is called only for the message which matches the type tags of the schema
+            template <typename... Ts, typename F>
+            void subscribe(const Schema<Ts...>& schema, F&& func) {
+                ElementRef ref(new element::TypedFunction<std::decay_t<F>, void, Ts...>(func));
+                callbacks.insert(schema.address(), ref);
+            }
+
+            // callback is called directly with the arguments (only int, float, double and int64 are allowed),
+            // and only for the message whose type tags are exactly same as its arguments
+            template <typename F>
+            void subscribeTyped(const String& addr, F&& func) {
+                ElementRef ref(new element::detail::typed_function_t<F>(func));
+                callbacks.insert(addr, ref);
+            }
+
+            // receive the chunks sent by Client::sendBlob() into the buffer of the reassembler
+            // the reassembler must be valid while the server is running
+            void subscribeBlob(const String& addr, blob::Reassembler& r) {
+                ElementRef ref(new element::BlobChunk(r));
+                callbacks.insert(addr, ref);
             }
 
             bool parse() {
-                auto stream = (is_multicast) ? UdpMapManager<S>::getInstance().getMulticastUdp(multicast, port, iface) :
-                                               UdpMapManager<S>::getInstance().getUdp(port);
+                bool received = false;
+                return parse(received);
+            }
+
+            // received is set to true if any packet was read even if it could not be parsed
+            bool parse(bool& received) {
+                const bool b = receive(received);
+                if (!in_pass && !coalescer.empty()) dispatchCoalesced();
+                return b;
+            }
+
+            // parse pending packets until no packet is left or the budget runs out
+            // 0 means no limit for each budget, returns the number of packets read
+            // messages to the coalescing subscriptions are collapsed over all the packets
+            size_t drain(const size_t max_packets, const uint32_t max_us = 0) {
+                const uint32_t begin_us = micros();
+                size_t n = 0;
+                bool received = true;
+                while (received) {
+                    if (max_packets && (n >= max_packets)) break;
+                    if (max_us && ((uint32_t)(micros() - begin_us) >= max_us)) break;
+                    receive(received);
+                    if (received) ++n;
+                }
+                if (!coalescer.empty()) dispatchCoalesced();
+                return n;
+            }
+
+            const OscMessage* message() const { return msg_ptr; }
+
+            // decode the received packets as MessageView and dispatch them without copying
+            // message() is not available (always nullptr) in this mode
+            void useMessageView(const bool b) { use_message_view = b; }
+            bool isMessageViewUsed() const { return use_message_view; }
+
+            // defer the messages in the bundle until their time tag comes (needs Clock to be set)
+            // deferred messages are dispatched in parse() and the callbacks receive the copied message
+            void useScheduler(const bool b) {
+                use_scheduler = b;
+                if (b)
+                    scheduler.reserve();
+                else
+                    dispatchScheduled(true);
+            }
+            bool isSchedulerUsed() const { return use_scheduler; }
+            const Scheduler& getScheduler() const { return scheduler; }
+
+            // packets larger than the receive buffer (ARDUINOOSC_RX_BUFFER_SIZE), which were discarded
+            uint32_t dropped() const { return num_dropped; }
+
+#ifdef ARDUINOOSC_ENABLE_STATS
+            // counters of this server, the counters of each subscription are in getDispatcher()
+            const ServerStats& stats() const { return server_stats; }
+            ServerStats& stats() { return server_stats; }
+            void resetStats() {
+                server_stats.reset();
+                callbacks.resetStats();
+            }
+#endif
+            const Dispatcher& getDispatcher() const { return callbacks; }
+
+            // unwrap the reliable envelopes, drop the duplicates and reply ACK / NACK through the receiver
+            // the receiver must be valid while the server is running, pass nullptr to stop it
+            void useReliable(reliable::Receiver* r) { reliable_rx = r; }
+            bool isReliableUsed() const { return reliable_rx != nullptr; }
+
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+            // post the matched messages to the workers instead of calling the callbacks in parse()
+            // the messages of one subscription always go to the same worker, so their order is kept
+            // workers can be shared by servers, pass nullptr to call the callbacks in parse() again
+            void useWorkers(DispatchWorker* w, const size_t n) {
+                workers = w;
+                num_workers = w ? n : 0;
+            }
+            void useWorker(DispatchWorker& w) { useWorkers(&w, 1); }
+            bool isWorkerUsed() const { return num_workers != 0; }
+#endif
+
+            // dispatch the deferred messages which are due (or all of them if force is true)
+            size_t dispatchScheduled(const bool force = false) {
+                auto f = [&](Message& m) { dispatch(m); };
+                return force ? scheduler.dispatchAll(f) : scheduler.dispatchDue(f);
+            }
+
+            // call the callback of the subscribed address only once with the newest message
+            // among the messages received in one parse() / drain() (window_us = 0),
+            // or in the time window which starts from the first message (window_us > 0)
+            // the address must be subscribed before, returns false if it is not found or no slot is left
+            bool coalesce(const String& addr, const uint32_t window_us = 0) {
+                const size_t idx = callbacks.indexOf(addr);
+                if (idx >= callbacks.size()) {
+                    LOG_ERROR(F("address is not subscribed:"), addr);
+                    return false;
+                }
+                const uint16_t slot = coalescer.add((uint16_t)idx, window_us);
+                if (slot == Coalescer::NO_SLOT) return false;
+                callbacks[idx].coalesce_slot = slot;
+                return true;
+            }
+
+            // dispatch the held newest messages whose window is over (or all of them if force is true)
+            // called at the end of parse() and drain()
+            size_t dispatchCoalesced(const bool force = false) {
+                auto fm = [&](const uint16_t idx, Message& m) { invoke(callbacks[idx], m); };
+                auto fv = [&](const uint16_t idx, const MessageView& v) { invoke(callbacks[idx], v); };
+                return force ? coalescer.dispatchAll(fm, fv) : coalescer.dispatchDue(fm, fv);
+            }
+
+            // number of the messages which were replaced by the newer one and not passed to the callbacks
+            uint32_t coalesced() const { return coalescer.coalesced(); }
+            const Coalescer& getCoalescer() const { return coalescer; }
+
+        private:
+            void bind() {
+                stream = (is_multicast) ? UdpMapManager<S>::getInstance().getMulticastUdp(multicast, port, iface) :
+                                          UdpMapManager<S>::getInstance().getUdp(port);
+            }
+
+            // read and dispatch one packet
+            bool receive(bool& received) {
+                if (use_scheduler) dispatchScheduled();
+
+                if (is_unbound) return false;
+                if (!stream) {
+                    bind();
+                    is_unbound = !stream;  // logged by UdpMapManager
+                    if (is_unbound) return false;
+                }
+
+                // the packet is left in the socket until the outer packet is parsed
+                bool& busy = RxBuffer::busy();
+                if (busy) {
+                    LOG_ERROR(F("receive buffer is in use, parse() should not be called from the callback"));
+                    received = false;
+                    return false;
+                }
 
                 const size_t size = stream->parsePacket();
+                received = (size != 0);
                 if (size == 0) return false;
+#ifdef ARDUINOOSC_ENABLE_STATS
+                rx_begin_us = micros();
+                ++server_stats.packets;
+                server_stats.bytes += size;
+#endif
+
+                // the rest of the packet is discarded by the next parsePacket()
+                if (size > RxBuffer::capacity()) {
+                    LOG_ERROR(F("packet is too large:"), size, F("must be <="), RxBuffer::capacity());
+                    ++num_dropped;
+#ifdef ARDUINOOSC_ENABLE_STATS
+                    ++server_stats.dropped;
+#endif
+                    msg_ptr = nullptr;
+                    return false;
+                }
+                const uint8_t* data = packetData(*stream, size, 0);
+                busy = true;
+
+#ifdef ARDUINOOSC_ENABLE_STATS
+                is_receiving = true;
+#endif
+                const bool b = use_message_view ? parseView(*stream, data, size)
+                                                : parseMessage(*stream, data, size);
+#ifdef ARDUINOOSC_ENABLE_STATS
+                is_receiving = false;
+#endif
+                busy = false;
+                return b;
+            }
+
+            // the transport which has the whole packet is parsed in place, others are read into the shared buffer
+            template <typename T>
+            static auto packetData(T& s, const size_t, int) -> decltype(s.packetData()) {
+                return s.packetData();
+            }
+            template <typename T>
+            static const uint8_t* packetData(T& s, const size_t size, long) {
+                RxBuffer& rx = RxBuffer::shared();
+                s.read(rx.data, size);
+                rx.size = size;
+                return rx.data;
+            }
+
+            // M is Message or const MessageView
+            template <typename M>
+            void invoke(Subscription& s, M& m) {
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+                if (num_workers) {
+                    // the callback completes later on the worker, so the latency is not measured
+                    // dropped messages are counted by the worker, not as dispatched
+                    const bool posted = workers[s.hash % num_workers].post(s.ref.get(), m);
+#ifdef ARDUINOOSC_ENABLE_STATS
+                    if (posted) ++s.dispatched;
+#else
+                    (void)posted;
+#endif
+                    return;
+                }
+#endif
+                s.ref->decodeFrom(m);
+#ifdef ARDUINOOSC_ENABLE_STATS
+                onDispatched(s);
+#endif
+            }
+
+            void dispatch(Message& m) {
+                if (reliable_rx && reliable::isEnvelope(m.address().c_str())) {
+                    dispatchReliable(m);
+                    return;
+                }
+                const String& addr = m.address();
+                const size_t n = this->callbacks.dispatch(addr.c_str(), addr.length(), [&](Subscription& s) {
+                    if (s.coalesce_slot != Coalescer::NO_SLOT)
+                        coalescer.hold(s.coalesce_slot, m);
+                    else
+                        invoke(s, m);
+                });
+#ifdef ARDUINOOSC_ENABLE_STATS
+                onDispatched(n);
+#else
+                (void)n;
+#endif
+            }
+
+            void dispatch(const MessageView& v) {
+                if (reliable_rx && reliable::isEnvelope(v.address())) {
+                    dispatchReliable(v);
+                    return;
+                }
+                const size_t n = this->callbacks.dispatch(v.address(), v.addressLength(), [&](Subscription& s) {
+                    if (s.coalesce_slot != Coalescer::NO_SLOT)
+                        coalescer.hold(s.coalesce_slot, v);
+                    else
+                        invoke(s, v);
+                });
+#ifdef ARDUINOOSC_ENABLE_STATS
+                onDispatched(n);
+#else
+                (void)n;
+#endif
+            }
+
+            // the inner message is decoded in the same mode as the envelope
+            void dispatchReliable(const Message& env) {
+                const uint8_t* data = nullptr;
+                size_t size = 0;
+                if (!reliable_rx->accept(env, env.remoteAddress(), port, data, size)) return;
+                Message m(data, size, env.timeTag());
+                if (!m.available()) {
+                    LOG_ERROR(F("reliable envelope has no valid message"));
+                    return;
+                }
+                m.remoteIP(env.remoteAddress());
+                m.remotePort(env.remotePort());
+                dispatch(m);
+            }
+
+            void dispatchReliable(const MessageView& env) {
+                const uint8_t* data = nullptr;
+                size_t size = 0;
+                if (!reliable_rx->accept(env, env.remoteIP(), port, data, size)) return;
+                MessageView v(data, size, env.timeTag());
+                if (!v.available()) {
+                    LOG_ERROR(F("reliable envelope has no valid message"));
+                    return;
+                }
+                v.remoteIP(env.remoteIP());
+                v.remotePort(env.remotePort());
+                dispatch(v);
+            }
 
-                uint8_t data[size];
-                stream->read(data, size);
+#ifdef ARDUINOOSC_ENABLE_STATS
+            void onDispatched(Subscription& s) {
+                ++s.dispatched;
+                // deferred messages are not measured because they are dispatched out of parse
+                if (is_receiving) server_stats.latency.add(micros() - rx_begin_us);
+            }
+            void onDispatched(const size_t num_matched) {
+                ++server_stats.messages;
+                if (num_matched == 0) ++server_stats.unmatched;
+            }
+            void onParseFailed() {
+                ++server_stats.parse_failures;
+            }
+#endif
 
+            bool parseMessage(S& stream, const uint8_t* data, const size_t size) {
+#ifdef ARDUINOOSC_ENABLE_STATS
+                if (!decoder.init(data, size)) onParseFailed();
+#else
                 decoder.init(data, size);
+#endif
+                const IPAddress ip = stream.S::remoteIP();
+                const uint16_t remote_port = (uint16_t)stream.S::remotePort();
                 while (Message* msg = decoder.decode()) {
                     if (msg->available()) {
-                        msg->remoteIP(stream->S::remoteIP());
-                        msg->remotePort((uint16_t)stream->S::remotePort());
-                        for (auto& c : this->callbacks) {
-                            if (msg->match(c.first)) {
-                                c.second->decodeFrom(*msg);
-                            }
-                        }
+                        msg->remoteIP(ip);
+                        msg->remotePort(remote_port);
+                        if (!use_scheduler || !scheduler.isDeferred(msg->timeTag()) || !scheduler.push(*msg))
+                            dispatch(*msg);
                         msg_ptr = msg;
                     } else {
                         LOG_ERROR(F("osc message parsing failed"));
+#ifdef ARDUINOOSC_ENABLE_STATS
+                        onParseFailed();
+#endif
                         msg_ptr = nullptr;
                     }
                 }
                 return msg_ptr != nullptr;
             }
 
-            const OscMessage* message() const { return msg_ptr; }
+            bool parseView(S& stream, const uint8_t* data, const size_t size) {
+                msg_ptr = nullptr;
+                if (!view_decoder.init(data, size)) {
+#ifdef ARDUINOOSC_ENABLE_STATS
+                    onParseFailed();
+#endif
+                    return false;
+                }
+
+                const IPAddress ip = stream.S::remoteIP();
+                const uint16_t remote_port = (uint16_t)stream.S::remotePort();
+                bool dispatched = false;
+                while (MessageView* view = view_decoder.decode()) {
+                    if (view->available()) {
+                        view->remoteIP(ip);
+                        view->remotePort(remote_port);
+                        if (!use_scheduler || !scheduler.isDeferred(view->timeTag()) || !scheduler.push(view->toMessage()))
+                            dispatch(*view);
+                        dispatched = true;
+                    } else {
+                        LOG_ERROR(F("osc message parsing failed"));
+#ifdef ARDUINOOSC_ENABLE_STATS
+                        onParseFailed();
+#endif
+                        dispatched = false;
+                    }
+                }
+                return dispatched;
+            }
         };
 
         template <typename S>
@@ -256,6 +752,10 @@ namespace osc {
             Manager& operator=(const Manager&) = delete;
 
             ServerMap<S> server_map;
+            bool drain_enabled {false};
+            size_t budget_packets {0};
+            uint32_t budget_us {0};
+            size_t first_server {0};
 
         public:
             static Manager& getInstance() {
@@ -268,8 +768,12 @@ namespace osc {
             }
 
             Server<S>& getServer(const uint16_t port) {
-                if (server_map.find(port) == server_map.end())
+                if (server_map.find(port) == server_map.end()) {
+#if ARX_HAVE_LIBSTDCPLUSPLUS < 201103L  // Don't have libstdc++11
+                    if (server_map.size() >= ARDUINOOSC_MAX_SUBSCRIBE_PORTS) return unbound(port);
+#endif
                     server_map.insert(std::make_pair(port, ServerRef<S>(new Server<S>(port))));
+                }
                 return *(server_map[port].get());
             }
 
@@ -285,8 +789,12 @@ namespace osc {
 
             Server<S>& getMulticastServer(const IPAddress& multicast, const uint16_t port, const IPAddress& iface)
             {
-                if (server_map.find(port) == server_map.end())
+                if (server_map.find(port) == server_map.end()) {
+#if ARX_HAVE_LIBSTDCPLUSPLUS < 201103L  // Don't have libstdc++11
+                    if (server_map.size() >= ARDUINOOSC_MAX_SUBSCRIBE_PORTS) return unbound(port);
+#endif
                     server_map.insert(std::make_pair(port, ServerRef<S>(new Server<S>(multicast, port, iface))));
+                }
                 return *(server_map[port].get());
             }
 
@@ -294,13 +802,107 @@ namespace osc {
             void subscribe(const uint16_t port, const String& addr, Ts&&... ts) {
                 getServer(port).subscribe(addr, std::forward<Ts>(ts)...);
             }
+            template <typename... Ts, typename F>
+            void subscribe(const uint16_t port, const Schema<Ts...>& schema, F&& func) {
+                getServer(port).subscribe(schema, std::forward<F>(func));
+            }
+            template <typename F>
+            void subscribeTyped(const uint16_t port, const String& addr, F&& func) {
+                getServer(port).subscribeTyped(addr, std::forward<F>(func));
+            }
+            void subscribeBlob(const uint16_t port, const String& addr, blob::Reassembler& r) {
+                getServer(port).subscribeBlob(addr, r);
+            }
+
+            // drain pending packets of all servers in parse() within the budget
+            // (0 means no limit for each budget) instead of one packet per server
+            void setParseBudget(const size_t max_packets, const uint32_t max_us = 0) {
+                drain_enabled = true;
+                budget_packets = max_packets;
+                budget_us = max_us;
+            }
+            // parse only one packet per server in parse() (default)
+            void resetParseBudget() {
+                drain_enabled = false;
+                budget_packets = 0;
+                budget_us = 0;
+            }
 
             void parse() {
-                for (auto& m : server_map)
-                    m.second->parse();
+                if (!drain_enabled) {
+                    for (auto& m : server_map)
+                        m.second->parse();
+                    return;
+                }
+
+                // messages to the coalescing subscriptions are collapsed over the whole budget
+                for (auto& m : server_map) m.second->in_pass = true;
+                parseWithinBudget();
+                for (auto& m : server_map) {
+                    m.second->in_pass = false;
+                    if (!m.second->coalescer.empty()) m.second->dispatchCoalesced();
+                }
+            }
+
+        private:
+            // the server over the capacity is not added and never bound, its parse() always fails
+            // (it is not aliased to the udp of another port)
+            Server<S>& unbound(const uint16_t port) {
+                LOG_ERROR(F("too many servers, max is"), ARDUINOOSC_MAX_SUBSCRIBE_PORTS, F(", not bound:"), port);
+                static Server<S> s(port);
+                s.is_unbound = true;
+                return s;
+            }
+
+            void parseWithinBudget() {
+                // read one packet from each server in turn so that a busy port does not starve others
+                // and start from the next server in the next call if the budget runs out in the middle
+                const size_t num_servers = server_map.size();
+                if (num_servers == 0) return;
+                const uint32_t begin_us = micros();
+                size_t n = 0;
+                bool any_received = true;
+                while (any_received) {
+                    any_received = false;
+                    auto it = server_map.begin();
+                    for (size_t i = 0; i < (first_server % num_servers); ++i) ++it;
+                    for (size_t i = 0; i < num_servers; ++i) {
+                        if (budget_packets && (n >= budget_packets)) return;
+                        if (budget_us && ((uint32_t)(micros() - begin_us) >= budget_us)) return;
+                        bool received = false;
+                        it->second->parse(received);
+                        if (received) {
+                            ++n;
+                            any_received = true;
+                        }
+                        first_server = (first_server + 1) % num_servers;
+                        if (++it == server_map.end()) it = server_map.begin();
+                    }
+                }
             }
         };
 
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+        inline size_t DispatchWorker::drain(const size_t max_jobs) {
+            size_t n = 0;
+            while (!max_jobs || (n < max_jobs)) {
+                DispatchJob* job = queue.front();
+                if (!job) break;
+                if (job->ref) {
+                    MessageView v(job->data, job->size, job->time_tag);
+                    v.remoteIP(job->ip);
+                    v.remotePort(job->port);
+                    if (v.available()) {
+                        job->ref->decodeFrom(v);
+                        ++n;
+                    }
+                }
+                queue.pop();
+            }
+            return n;
+        }
+#endif
+
     }  // namespace server
 }  // namespace osc
 }  // namespace arduino
@@ -0,0 +1,163 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCARENA_H
+#define ARDUINOOSC_OSCARENA_H
+
+#include <Arduino.h>
+#include <ArxTypeTraits.h>
+
+#ifndef ARDUINOOSC_ELEMENT_ARENA_SIZE
+#define ARDUINOOSC_ELEMENT_ARENA_SIZE 0  // 0: elements are allocated on the heap
+#endif
+
+namespace arduino {
+namespace osc {
+
+    // base of the objects which are owned by RefPtr, the count lives in the object itself
+    // so that no control block is allocated unlike std::shared_ptr
+    class RefCounted {
+        template <typename T>
+        friend class RefPtr;
+
+        mutable uint16_t ref_count {0};
+
+    protected:
+        RefCounted() {}
+        RefCounted(const RefCounted&) {}
+        RefCounted& operator=(const RefCounted&) { return *this; }
+        ~RefCounted() {}
+    };
+
+    // intrusive reference counted pointer, T must derive from RefCounted and have a virtual destructor
+    // if it is deleted via the pointer to base
+    template <typename T>
+    class RefPtr {
+        template <typename U>
+        friend class RefPtr;
+
+        T* p {nullptr};
+
+    public:
+        RefPtr() {}
+        RefPtr(decltype(nullptr)) {}
+        explicit RefPtr(T* ptr)
+        : p(ptr) { retain(); }
+        RefPtr(const RefPtr& r)
+        : p(r.p) { retain(); }
+        RefPtr(RefPtr&& r) noexcept
+        : p(r.p) { r.p = nullptr; }
+        template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+        RefPtr(const RefPtr<U>& r)
+        : p(r.p) { retain(); }
+
+        ~RefPtr() { release(); }
+
+        RefPtr& operator=(const RefPtr& r) {
+            if (p != r.p) {
+                r.retain();
+                release();
+                p = r.p;
+            }
+            return *this;
+        }
+        RefPtr& operator=(RefPtr&& r) noexcept {
+            if (this != &r) {
+                release();
+                p = r.p;
+                r.p = nullptr;
+            }
+            return *this;
+        }
+        RefPtr& operator=(decltype(nullptr)) {
+            reset();
+            return *this;
+        }
+
+        void reset() {
+            release();
+            p = nullptr;
+        }
+
+        T* get() const { return p; }
+        T& operator*() const { return *p; }
+        T* operator->() const { return p; }
+        explicit operator bool() const { return p != nullptr; }
+        size_t use_count() const { return p ? p->ref_count : 0; }
+
+        bool operator==(const RefPtr& r) const { return p == r.p; }
+        bool operator!=(const RefPtr& r) const { return p != r.p; }
+        bool operator==(decltype(nullptr)) const { return p == nullptr; }
+        bool operator!=(decltype(nullptr)) const { return p != nullptr; }
+
+    private:
+        void retain() const {
+            if (p) ++p->ref_count;
+        }
+        void release() {
+            if (p && (--p->ref_count == 0)) delete p;
+        }
+    };
+
+    // bump allocator for subscribe / publish elements, which are created once and rarely destroyed
+    // elements are allocated on the heap when the arena is disabled (size 0) or exhausted,
+    // and the space in the arena is reclaimed only if the last allocated element is destroyed
+    class ElementArena {
+        static constexpr size_t ALIGN {8};
+        static constexpr size_t CAPACITY {(ARDUINOOSC_ELEMENT_ARENA_SIZE + ALIGN - 1) & ~(ALIGN - 1)};
+
+        alignas(8) uint8_t buffer[CAPACITY ? CAPACITY : ALIGN];
+        size_t used {0};
+
+        ElementArena() {}
+        ElementArena(const ElementArena&) = delete;
+        ElementArena& operator=(const ElementArena&) = delete;
+
+    public:
+        static ElementArena& getInstance() {
+            static ElementArena a;
+            return a;
+        }
+
+        void* allocate(const size_t sz) {
+            const size_t sz_aligned = (sz + ALIGN - 1) & ~(ALIGN - 1);
+            if (used + sz_aligned <= CAPACITY) {
+                void* p = buffer + used;
+                used += sz_aligned;
+                return p;
+            }
+            return ::operator new(sz);
+        }
+
+        void deallocate(void* p, const size_t sz) {
+            if (!contains(p)) {
+                ::operator delete(p);
+                return;
+            }
+            const size_t sz_aligned = (sz + ALIGN - 1) & ~(ALIGN - 1);
+            if ((uint8_t*)p + sz_aligned == buffer + used) used -= sz_aligned;
+        }
+
+        bool contains(const void* p) const {
+            return ((uintptr_t)p >= (uintptr_t)buffer) && ((uintptr_t)p < (uintptr_t)(buffer + CAPACITY));
+        }
+
+        size_t size() const { return used; }
+        size_t capacity() const { return CAPACITY; }
+    };
+
+    // allocate the derived objects in ElementArena
+    struct ArenaAllocated {
+        static void* operator new(size_t sz) {
+            return ElementArena::getInstance().allocate(sz);
+        }
+        static void operator delete(void* p, size_t sz) {
+            ElementArena::getInstance().deallocate(p, sz);
+        }
+    };
+
+}  // namespace osc
+}  // namespace arduino
+
+using OscElementArena = arduino::osc::ElementArena;
+
+#endif  // ARDUINOOSC_OSCARENA_H
@@ -0,0 +1,183 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCASYNCUDP_H
+#define ARDUINOOSC_OSCASYNCUDP_H
+
+#include <Arduino.h>
+#include <ArxTypeTraits.h>
+#include "OscTypes.h"
+#include "OscRing.h"
+
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+
+#include <atomic>
+#include <vector>
+
+#ifndef ARDUINOOSC_ASYNC_UDP_RING_SIZE
+#define ARDUINOOSC_ASYNC_UDP_RING_SIZE 4  // datagrams per port, must be power of 2
+#endif
+
+namespace arduino {
+namespace osc {
+
+    // udp transport on the callback of AsyncUDP (lwIP), to be used as S of Manager / Server / Client
+    // received datagrams are copied into the SpscRing in the network task,
+    // and parsePacket() only takes them out of the ring in the loop task, so nothing is polled from lwIP
+    // the server parses the datagram in the slot of the ring (packetData()), so it is copied only once
+    // A is the async udp (AsyncUDP) and P is its packet (AsyncUDPPacket)
+    template <typename A, typename P, size_t N = ARDUINOOSC_ASYNC_UDP_RING_SIZE>
+    class AsyncUdpTransport {
+        struct Datagram {
+            uint8_t data[ARDUINOOSC_RX_BUFFER_SIZE];
+            size_t size {0};
+            IPAddress ip;
+            uint16_t port {0};
+        };
+
+        A udp;
+        SpscRing<Datagram, N> ring;
+        std::atomic<uint32_t> num_dropped {0};
+        void (*on_receive)(void*) {nullptr};
+        void* on_receive_arg {nullptr};
+        uint16_t local_port {0};
+
+        // consumer side
+        Datagram* rx {nullptr};
+        size_t rx_pos {0};
+
+        // sender side
+        std::vector<uint8_t> tx;
+        IPAddress tx_ip;
+        uint16_t tx_port {0};
+        bool is_tx_began {false};
+
+    public:
+        AsyncUdpTransport() {}
+        AsyncUdpTransport(const AsyncUdpTransport&) = delete;
+        AsyncUdpTransport& operator=(const AsyncUdpTransport&) = delete;
+        ~AsyncUdpTransport() { stop(); }
+
+        uint8_t begin(const uint16_t port) {
+            local_port = port;
+            if (!udp.listen(port)) return 0;
+            udp.onPacket(&AsyncUdpTransport::received, this);
+            return 1;
+        }
+
+        // AsyncUDP joins the group on the default interface (listenMulticast() takes tcpip_adapter_if_t, not the address),
+        // so iface is ignored
+        uint8_t beginMulticast(const IPAddress& iface, const IPAddress& multicast, const uint16_t port) {
+            (void)iface;
+            local_port = port;
+            if (!udp.listenMulticast(multicast, port)) return 0;
+            udp.onPacket(&AsyncUdpTransport::received, this);
+            return 1;
+        }
+
+        void stop() { udp.close(); }
+
+        // called in the network task after a datagram is pushed to the ring,
+        // e.g. xTaskNotifyGive() to wake up the task which dispatches
+        void onReceive(void (*cb)(void*), void* arg = nullptr) {
+            on_receive = cb;
+            on_receive_arg = arg;
+        }
+
+        // datagrams discarded because the ring was full or they were larger than ARDUINOOSC_RX_BUFFER_SIZE
+        uint32_t dropped() const { return num_dropped.load(std::memory_order_relaxed); }
+        size_t pending() const { return ring.size(); }
+        uint16_t localPort() const { return local_port; }
+
+        // receiver interface of WiFiUDP
+
+        int parsePacket() {
+            if (rx) {
+                ring.pop();
+                rx = nullptr;
+            }
+            rx = ring.front();
+            rx_pos = 0;
+            return rx ? (int)rx->size : 0;
+        }
+
+        int available() { return rx ? (int)(rx->size - rx_pos) : 0; }
+
+        int read(uint8_t* buffer, const size_t len) {
+            const size_t n = (size_t)available() < len ? (size_t)available() : len;
+            if (n) memcpy(buffer, rx->data + rx_pos, n);
+            rx_pos += n;
+            return (int)n;
+        }
+        int read(char* buffer, const size_t len) { return read((uint8_t*)buffer, len); }
+
+        // the datagram is parsed by the server in the slot of the ring, which is released at the next parsePacket()
+        const uint8_t* packetData() const { return rx ? rx->data : nullptr; }
+
+        IPAddress remoteIP() { return rx ? rx->ip : IPAddress(); }
+        uint16_t remotePort() { return rx ? rx->port : 0; }
+
+        // sender interface of WiFiUDP, the packet is sent by AsyncUDP::writeTo() at endPacket()
+        // host name is not resolved, only the dotted ip address string is accepted
+
+        int beginPacket(const IPAddress& ip, const uint16_t port) {
+            tx.clear();
+            tx_ip = ip;
+            tx_port = port;
+            is_tx_began = true;
+            return 1;
+        }
+        int beginPacket(const char* host, const uint16_t port) {
+            IPAddress ip;
+            if (!ip.fromString(host)) return 0;
+            return beginPacket(ip, port);
+        }
+        // AsyncUDP::writeTo() has no ttl and picks the interface by the route of the group,
+        // so iface and ttl are ignored: packets go out of the default interface with the ttl of the pcb (1)
+        // (use WiFiUDP as the client instead if the interface or the ttl must be chosen)
+        int beginPacketMulticast(const IPAddress& ip, const uint16_t port, const IPAddress& iface, const int ttl = 1) {
+            (void)iface;
+            (void)ttl;
+            return beginPacket(ip, port);
+        }
+
+        size_t write(const uint8_t* buffer, const size_t size) {
+            if (!is_tx_began) return 0;
+            tx.insert(tx.end(), buffer, buffer + size);
+            return size;
+        }
+        size_t write(const uint8_t c) { return write(&c, 1); }
+
+        int endPacket() {
+            if (!is_tx_began) return 0;
+            is_tx_began = false;
+            return (udp.writeTo(tx.data(), tx.size(), tx_ip, tx_port) == tx.size()) ? 1 : 0;
+        }
+
+    private:
+        // producer side, runs in the network task
+        static void received(void* arg, P& packet) {
+            AsyncUdpTransport* self = (AsyncUdpTransport*)arg;
+            const size_t size = packet.length();
+            Datagram* d = (size <= ARDUINOOSC_RX_BUFFER_SIZE) ? self->ring.reserve() : nullptr;
+            if (!d) {
+                self->num_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            memcpy(d->data, packet.data(), size);
+            d->size = size;
+            d->ip = packet.remoteIP();
+            d->port = packet.remotePort();
+            self->ring.commit();
+            if (self->on_receive) self->on_receive(self->on_receive_arg);
+        }
+    };
+
+}  // namespace osc
+}  // namespace arduino
+
+template <typename A, typename P, size_t N = ARDUINOOSC_ASYNC_UDP_RING_SIZE>
+using OscAsyncUdpTransport = arduino::osc::AsyncUdpTransport<A, P, N>;
+
+#endif  // Have libstdc++11
+
+#endif  // ARDUINOOSC_OSCASYNCUDP_H
@@ -0,0 +1,236 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCBLOB_H
+#define ARDUINOOSC_OSCBLOB_H
+
+#include <Arduino.h>
+#include <ArxTypeTraits.h>
+#include <DebugLog.h>
+#include "OscTypes.h"
+#include "OscUtil.h"
+#include "OscMessage.h"
+#include "OscMessageView.h"
+#include "OscSchema.h"
+
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+#ifndef ARDUINOOSC_BLOB_CHUNK_SIZE
+#define ARDUINOOSC_BLOB_CHUNK_SIZE 1024  // chunk message fits in ethernet mtu
+#endif
+#else
+#ifndef ARDUINOOSC_BLOB_CHUNK_SIZE
+#define ARDUINOOSC_BLOB_CHUNK_SIZE 64  // chunk message fits in ARDUINOOSC_MAX_MSG_BYTE_SIZE
+#endif
+#endif
+#ifndef ARDUINOOSC_BLOB_MAX_CHUNKS
+#define ARDUINOOSC_BLOB_MAX_CHUNKS 64
+#endif
+
+namespace arduino {
+namespace osc {
+    namespace blob {
+
+        // each chunk is one message: address ,iiiiib
+        // transfer id, chunk index, number of chunks, total size, offset of the chunk, chunk data
+        static constexpr size_t NUM_ARGS {6};
+        static constexpr const char* TYPE_TAGS {"iiiiib"};
+        static constexpr size_t INTS_SIZE {(NUM_ARGS - 1) * 4 + 4};  // ints and the size of the blob
+
+        // splits the user buffer into the chunk messages
+        // the buffer is not copied, it must be valid while the chunks are sent (and resent)
+        class Chunker {
+            Blob header_bytes;  // address and type tags, encoded once
+            const uint8_t* src {nullptr};
+            size_t total {0};
+            size_t chunk_size {0};
+            size_t count {0};
+            uint32_t id {0};
+            char prefix_buf[INTS_SIZE];
+
+        public:
+            explicit Chunker(const String& addr, const size_t chunk_size = ARDUINOOSC_BLOB_CHUNK_SIZE)
+            : chunk_size(chunk_size ? chunk_size : 1), id(micros()) {
+                const size_t addr_size = ceil4(addr.length() + 1);
+                header_bytes.resize(addr_size + ceil4(NUM_ARGS + 2));  // filled with zeros, so the zero padding is OK
+                memcpy(&header_bytes[0], addr.c_str(), addr.length());
+                header_bytes[addr_size] = ',';
+                memcpy(&header_bytes[addr_size + 1], TYPE_TAGS, NUM_ARGS);
+            }
+
+            // start a new transfer of the buffer, returns false if it needs more than ARDUINOOSC_BLOB_MAX_CHUNKS
+            bool begin(const void* data, const size_t size) {
+                const size_t n = size ? (size + chunk_size - 1) / chunk_size : 1;
+                if (n > ARDUINOOSC_BLOB_MAX_CHUNKS) {
+                    LOG_ERROR(F("too many blob chunks:"), n, F("must be <="), ARDUINOOSC_BLOB_MAX_CHUNKS);
+                    count = 0;
+                    return false;
+                }
+                src = (const uint8_t*)data;
+                total = size;
+                count = n;
+                ++id;
+                return true;
+            }
+
+            uint32_t transferId() const { return id; }
+            size_t numChunks() const { return count; }
+            size_t size() const { return total; }
+            size_t chunkSize() const { return chunk_size; }
+
+            // encoded chunk message = header() + prefix(i) + payload(i) + padding(i) zeros
+            const uint8_t* header() const { return (const uint8_t*)header_bytes.data(); }
+            size_t headerSize() const { return header_bytes.size(); }
+
+            const uint8_t* prefix(const size_t i) {
+                const size_t offset = i * chunk_size;
+                char* p = prefix_buf;
+                pod2bytes<int32_t>((int32_t)id, p);
+                pod2bytes<int32_t>((int32_t)i, p + 4);
+                pod2bytes<int32_t>((int32_t)count, p + 8);
+                pod2bytes<int32_t>((int32_t)total, p + 12);
+                pod2bytes<int32_t>((int32_t)offset, p + 16);
+                pod2bytes<int32_t>((int32_t)payloadSize(i), p + 20);
+                return (const uint8_t*)prefix_buf;
+            }
+            static constexpr size_t prefixSize() { return INTS_SIZE; }
+
+            const uint8_t* payload(const size_t i) const { return src ? (src + i * chunk_size) : nullptr; }
+            size_t payloadSize(const size_t i) const {
+                if (i >= count) return 0;
+                const size_t offset = i * chunk_size;
+                return ((total - offset) < chunk_size) ? (total - offset) : chunk_size;
+            }
+            size_t padding(const size_t i) const { return ceil4(payloadSize(i)) - payloadSize(i); }
+
+            size_t encodedSize(const size_t i) const { return headerSize() + prefixSize() + ceil4(payloadSize(i)); }
+        };
+
+        // reassembles the chunks of one transfer into the user buffer
+        // the chunk data is copied directly from the received packet into the buffer at its offset
+        class Reassembler {
+        public:
+            using Callback = std::function<void(const uint8_t*, const size_t)>;
+
+        private:
+            uint8_t* buf {nullptr};
+            size_t capacity {0};
+            Callback on_complete;
+
+            uint32_t id {0};
+            size_t total {0};
+            size_t count {0};
+            size_t num_received {0};
+            uint32_t received[(ARDUINOOSC_BLOB_MAX_CHUNKS + 31) / 32];
+            bool is_began {false};
+            bool is_complete {false};
+            uint32_t num_rejected {0};
+
+        public:
+            Reassembler(void* buffer, const size_t capacity)
+            : buf((uint8_t*)buffer), capacity(capacity) {
+                clearReceived();
+            }
+            Reassembler(void* buffer, const size_t capacity, const Callback& cb)
+            : buf((uint8_t*)buffer), capacity(capacity), on_complete(cb) {
+                clearReceived();
+            }
+
+            // called once with the buffer and the size of the blob when all chunks are received
+            void onComplete(const Callback& cb) { on_complete = cb; }
+
+            // M is Message or MessageView, returns false if it is not a valid chunk
+            // a chunk with a different transfer id starts a new transfer and discards the current one
+            template <typename M>
+            bool feed(const M& m) {
+                if ((m.size() != NUM_ARGS) || (memcmp(message::schema::type_tags_of(m), TYPE_TAGS, NUM_ARGS) != 0))
+                    return reject(F("blob chunk type tags mismatch:"), message::schema::type_tags_of(m));
+
+                const uint32_t tid = (uint32_t)m.getArgAsInt32(0);
+                const size_t index = (size_t)m.getArgAsInt32(1);
+                const size_t n = (size_t)m.getArgAsInt32(2);
+                const size_t sz = (size_t)m.getArgAsInt32(3);
+                const size_t offset = (size_t)m.getArgAsInt32(4);
+                size_t len = 0;
+                const uint8_t* p = m.getArgAsBlobPtr(5, len);
+
+                if ((n == 0) || (n > ARDUINOOSC_BLOB_MAX_CHUNKS) || (index >= n))
+                    return reject(F("invalid blob chunk index:"), index);
+                if (sz > capacity)
+                    return reject(F("blob is too large:"), sz);
+                if ((offset > sz) || (len > sz - offset) || (len && !p))
+                    return reject(F("invalid blob chunk range:"), offset);
+
+                if (!is_began || (tid != id) || (n != count) || (sz != total)) {
+                    is_began = true;
+                    is_complete = false;
+                    id = tid;
+                    count = n;
+                    total = sz;
+                    num_received = 0;
+                    clearReceived();
+                }
+                if (isReceived(index)) return true;  // duplicated
+
+                if (len) memcpy(buf + offset, p, len);
+                received[index / 32] |= (uint32_t)1 << (index % 32);
+                if (++num_received == count) {
+                    is_complete = true;
+                    if (on_complete) on_complete(buf, total);
+                }
+                return true;
+            }
+
+            // missing-chunk report of the current transfer
+            // writes the indices of the missing chunks (up to max_indices), returns the number of them
+            size_t missing(uint16_t* indices, const size_t max_indices) const {
+                size_t n = 0;
+                for (size_t i = 0; i < count; ++i) {
+                    if (isReceived(i)) continue;
+                    if (indices && (n < max_indices)) indices[n] = (uint16_t)i;
+                    ++n;
+                }
+                return n;
+            }
+            size_t numMissing() const { return count - num_received; }
+            bool isReceived(const size_t index) const {
+                return (index < count) && (received[index / 32] & ((uint32_t)1 << (index % 32)));
+            }
+
+            bool isBegan() const { return is_began; }
+            bool isComplete() const { return is_complete; }
+            uint32_t transferId() const { return id; }
+            size_t numChunks() const { return count; }
+            size_t numReceived() const { return num_received; }
+            size_t size() const { return total; }
+            const uint8_t* data() const { return buf; }
+            // chunks which were not valid (wrong type tags, out of range or larger than the buffer)
+            uint32_t rejected() const { return num_rejected; }
+
+            // forget the current transfer, e.g. after the buffer is consumed
+            void reset() {
+                is_began = is_complete = false;
+                id = 0;
+                total = count = num_received = 0;
+                clearReceived();
+            }
+
+        private:
+            void clearReceived() {
+                for (auto& r : received) r = 0;
+            }
+
+            template <typename Msg, typename T>
+            bool reject(const Msg& msg, const T& t) {
+                LOG_ERROR(msg, t);
+                ++num_rejected;
+                return false;
+            }
+        };
+
+    }  // namespace blob
+}  // namespace osc
+}  // namespace arduino
+
+using OscBlobChunker = arduino::osc::blob::Chunker;
+using OscBlobReassembler = arduino::osc::blob::Reassembler;
+
+#endif  // ARDUINOOSC_OSCBLOB_H
@@ -0,0 +1,168 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCCLOCK_H
+#define ARDUINOOSC_OSCCLOCK_H
+
+#include <Arduino.h>
+#include "OscTypes.h"
+
+namespace arduino {
+namespace osc {
+
+    // maps osc (ntp) time tag to local micros()
+    // the anchor is moved forward before micros() elapsed from it overflows,
+    // so now() must be called at least once in about 35 minutes
+    class Clock {
+        Clock() {}
+        Clock(const Clock&) = delete;
+        Clock& operator=(const Clock&) = delete;
+
+        static constexpr int32_t MAX_DRIFT_PPB {500000};       // 500 ppm
+        static constexpr int32_t MAX_SLEW_PPB {100000000};     // 10 %, so that the clock never runs backwards
+
+        uint64_t anchor_ntp {0};
+        uint32_t anchor_us {0};
+        int32_t drift_ppb {0};  // rate correction of local micros() in parts per billion
+        int32_t slew_ppb {0};   // temporary rate correction until slew_left_ns is applied
+        int64_t slew_left_ns {0};
+        uint64_t last_ntp {0};  // now() does not return the time before this unless the clock is stepped
+        bool is_set {false};
+
+    public:
+        static Clock& getInstance() {
+            static Clock c;
+            return c;
+        }
+
+        // set current time
+        void set(const TimeTag& tt) {
+            anchor_ntp = tt.value();
+            anchor_us = micros();
+            slew_ppb = 0;
+            slew_left_ns = 0;
+            last_ntp = 0;
+            is_set = true;
+        }
+
+        bool isSet() const { return is_set; }
+
+        // step the current time by us
+        void adjust(const int64_t us) {
+            if (!is_set) return;
+            reanchor();
+            anchor_ntp += (uint64_t)ntpFromUs(us);
+            last_ntp = 0;
+        }
+
+        // correct the current time by us gradually in period_us by changing the rate temporarily
+        // the rate is limited to +-10 %, so the clock keeps moving forward (it takes longer if limited)
+        // the previous slew which is not completed is replaced
+        void slew(const int64_t us, const uint32_t period_us) {
+            if (!is_set) return;
+            reanchor();
+            slew_left_ns = us * 1000;
+            if (period_us == 0) {
+                slew_ppb = (us > 0) ? MAX_SLEW_PPB : (us < 0) ? -MAX_SLEW_PPB : 0;
+                return;
+            }
+            const int64_t ppb = us * 1000000000LL / (int64_t)period_us;
+            slew_ppb = (int32_t)((ppb > MAX_SLEW_PPB) ? MAX_SLEW_PPB : (ppb < -MAX_SLEW_PPB) ? -MAX_SLEW_PPB : ppb);
+            if ((slew_ppb == 0) && us) slew_ppb = (us > 0) ? 1 : -1;
+        }
+        // correction which is not applied yet
+        int64_t slewRemaining() const {
+            return (slew_left_ns - slewedNs(micros() - anchor_us)) / 1000;
+        }
+        bool isSlewing() const { return slewRemaining() != 0; }
+
+        // correct the rate of local micros(): positive value makes the clock faster
+        void setDrift(const int32_t ppb) {
+            if (is_set) reanchor();
+            drift_ppb = (ppb > MAX_DRIFT_PPB) ? MAX_DRIFT_PPB : (ppb < -MAX_DRIFT_PPB) ? -MAX_DRIFT_PPB : ppb;
+        }
+        int32_t drift() const { return drift_ppb; }
+
+        // returns immediate if the clock is not set
+        TimeTag now() {
+            if (!is_set) return TimeTag::immediate();
+            const uint32_t us = micros();
+            const uint32_t elapsed = us - anchor_us;
+            uint64_t ntp = anchor_ntp + elapsedToNtp(elapsed) + (uint64_t)slewToNtp(elapsed);
+            if (elapsed >= (1UL << 31)) reanchor();
+            // rounding of the slew must not move it backwards
+            if ((int64_t)(ntp - last_ntp) < 0)
+                ntp = last_ntp;
+            else
+                last_ntp = ntp;
+            return TimeTag(ntp);
+        }
+
+        // microseconds from now to tt, negative if tt is in the past
+        int64_t microsUntil(const TimeTag& tt) {
+            return ntpToUs((int64_t)(tt.value() - now().value()));
+        }
+
+        static uint64_t usToNtp(const uint32_t us) {
+            return ((uint64_t)us << 32) / 1000000ULL;
+        }
+
+        static int64_t ntpFromUs(const int64_t us) {
+            const bool neg = us < 0;
+            const uint64_t v = neg ? (uint64_t)(-us) : (uint64_t)us;
+            const int64_t ntp = (int64_t)(((v / 1000000ULL) << 32) + (((v % 1000000ULL) << 32) / 1000000ULL));
+            return neg ? -ntp : ntp;
+        }
+
+        static int64_t ntpToUs(const int64_t ntp) {
+            const bool neg = ntp < 0;
+            const uint64_t v = neg ? (uint64_t)(-ntp) : (uint64_t)ntp;
+            const int64_t us = (int64_t)((v >> 32) * 1000000ULL + (((v & 0xFFFFFFFFULL) * 1000000ULL) >> 32));
+            return neg ? -us : us;
+        }
+
+    private:
+        uint64_t elapsedToNtp(const uint32_t elapsed) const {
+            const uint64_t ntp = usToNtp(elapsed);
+            if (drift_ppb == 0) return ntp;
+            // ntp < 2^43 and |drift| <= 5 * 10^5, so that it does not overflow
+            return ntp + (uint64_t)((int64_t)ntp * drift_ppb / 1000000000LL);
+        }
+
+        // slew applied in elapsed microseconds from the anchor
+        int64_t slewedNs(const uint32_t elapsed) const {
+            if (slew_left_ns == 0) return 0;
+            // elapsed < 2^32 and |slew| <= 10^8, so that it does not overflow
+            const int64_t ns = (int64_t)elapsed * slew_ppb / 1000000LL;
+            if (slew_left_ns > 0) return (ns > slew_left_ns) ? slew_left_ns : ns;
+            return (ns < slew_left_ns) ? slew_left_ns : ns;
+        }
+
+        int64_t slewToNtp(const uint32_t elapsed) const {
+            const int64_t ns = slewedNs(elapsed);
+            if (ns == 0) return 0;
+            // |ns| <= 4.3 * 10^8 (10 % of 2^32 us), so that it does not overflow
+            return (ns >= 0) ? (int64_t)(((uint64_t)ns << 32) / 1000000000ULL) : -(int64_t)(((uint64_t)(-ns) << 32) / 1000000000ULL);
+        }
+
+        void reanchor() {
+            const uint32_t us = micros();
+            const uint32_t elapsed = us - anchor_us;
+            const int64_t ns = slewedNs(elapsed);
+            anchor_ntp += elapsedToNtp(elapsed) + (uint64_t)slewToNtp(elapsed);
+            anchor_us = us;
+            slew_left_ns -= ns;
+            if (slew_left_ns == 0) slew_ppb = 0;
+        }
+    };
+
+    inline TimeTag TimeTag::now() {
+        return Clock::getInstance().now();
+    }
+
+}  // namespace osc
+}  // namespace arduino
+
+using OscClockManager = arduino::osc::Clock;
+#define OscClock OscClockManager::getInstance()
+
+#endif  // ARDUINOOSC_OSCCLOCK_H
@@ -0,0 +1,189 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCCLOCKSYNC_H
+#define ARDUINOOSC_OSCCLOCKSYNC_H
+
+#include <Arduino.h>
+#include <DebugLog.h>
+#include "OscTypes.h"
+#include "OscClock.h"
+#include "OSCServer.h"
+#include "OSCClient.h"
+
+#ifndef ARDUINOOSC_CLOCK_SYNC_WINDOW
+#define ARDUINOOSC_CLOCK_SYNC_WINDOW 8
+#endif
+#ifndef ARDUINOOSC_CLOCK_SYNC_JITTER_US
+#define ARDUINOOSC_CLOCK_SYNC_JITTER_US 200
+#endif
+#ifndef ARDUINOOSC_CLOCK_SYNC_STEP_US
+#define ARDUINOOSC_CLOCK_SYNC_STEP_US 5000
+#endif
+
+namespace arduino {
+namespace osc {
+
+    // synchronizes Clock of this node to the master node by osc ping-pong
+    //   slave  -> master : /sync/ping (int32 slave micros, int32 reply port)
+    //   master -> slave  : /sync/pong (int32 slave micros, int64 master time tag)
+    // the master time is estimated as master time tag + half of the round trip,
+    // and only the samples whose round trip is close to the minimum in the window are used.
+    // small offsets are slewed over the next sync interval (the clock never runs backwards) and
+    // the drift is estimated from them, large ones are stepped
+    template <typename S>
+    class ClockSync {
+        ClockSync() {}
+        ClockSync(const ClockSync&) = delete;
+        ClockSync& operator=(const ClockSync&) = delete;
+
+        // slave
+        String master_ip;
+        uint16_t master_port {0};
+        uint16_t reply_port {0};
+        uint32_t interval_us {1000000};
+        uint32_t last_ping_us {0};
+        bool is_running {false};
+
+        uint32_t rtts[ARDUINOOSC_CLOCK_SYNC_WINDOW];
+        size_t num_rtts {0};
+        size_t rtt_idx {0};
+
+        bool has_synced {false};
+        uint32_t last_sync_us {0};
+        int64_t last_offset_us {0};
+        uint32_t last_rtt_us {0};
+        uint32_t num_samples {0};
+        uint32_t num_rejected {0};
+
+        uint16_t ping_port {0};  // pings are subscribed on it
+        uint16_t pong_port {0};  // pongs are subscribed on it
+
+    public:
+        static ClockSync<S>& getInstance() {
+            static ClockSync<S> s;
+            return s;
+        }
+
+        static const char* pingAddress() { return "/sync/ping"; }
+        static const char* pongAddress() { return "/sync/pong"; }
+
+        // answer the pings received on the port as the master
+        // the clock starts from unix epoch if it has not been set
+        // calling it again on the same port does not subscribe the pings twice
+        void serve(const uint16_t port) {
+            Clock& clock = Clock::getInstance();
+            if (!clock.isSet()) clock.set(TimeTag::fromUnixTime(0));
+            if (ping_port == port) return;
+            ping_port = port;
+
+            server::Manager<S>::getInstance().getServer(port).subscribe(pingAddress(), [](const message::Message& m) {
+                if (m.size() < 2) return;
+                message::Message pong(pongAddress());
+                pong.pushInt32(m.getArgAsInt32(0));
+                pong.pushInt64((int64_t)TimeTag::now().value());
+                client::Manager<S>::getInstance().getClient().send(m.remoteIP(), (uint16_t)m.getArgAsInt32(1), pong);
+            });
+        }
+
+        // synchronize to the master, pongs are received on recv_port
+        // calling it again (e.g. after end()) restarts the sync without subscribing the pongs twice
+        void begin(const String& ip, const uint16_t port, const uint16_t recv_port, const uint32_t interval_ms = 1000) {
+            master_ip = ip;
+            master_port = port;
+            reply_port = recv_port;
+            interval_us = interval_ms * 1000;
+            reset();
+            is_running = true;
+
+            if (pong_port != recv_port) {
+                pong_port = recv_port;
+                server::Manager<S>::getInstance().getServer(recv_port).subscribe(pongAddress(), [](const message::Message& m) {
+                    if (m.size() < 2) return;
+                    ClockSync<S>::getInstance().onPong((uint32_t)m.getArgAsInt32(0), (uint64_t)m.getArgAsInt64(1));
+                });
+            }
+            ping();
+        }
+
+        void end() {
+            is_running = false;
+        }
+
+        // send ping in the interval
+        void update() {
+            if (!is_running) return;
+            if ((uint32_t)(micros() - last_ping_us) >= interval_us) ping();
+        }
+
+        void ping() {
+            last_ping_us = micros();
+            message::Message m(pingAddress());
+            m.pushInt32((int32_t)last_ping_us);
+            m.pushInt32((int32_t)reply_port);
+            client::Manager<S>::getInstance().getClient().send(master_ip, master_port, m);
+        }
+
+        void reset() {
+            num_rtts = rtt_idx = 0;
+            has_synced = false;
+            last_offset_us = 0;
+            last_rtt_us = 0;
+            num_samples = num_rejected = 0;
+        }
+
+        bool isRunning() const { return is_running; }
+        bool isSynced() const { return has_synced; }
+        // offset of the clock before the last correction in microseconds
+        int64_t offset() const { return last_offset_us; }
+        uint32_t roundTrip() const { return last_rtt_us; }
+        uint32_t samples() const { return num_samples; }
+        uint32_t rejected() const { return num_rejected; }
+
+        void onPong(const uint32_t t0_us, const uint64_t master_ntp) {
+            const uint32_t t3_us = micros();
+            const uint32_t rtt = t3_us - t0_us;
+            ++num_samples;
+            last_rtt_us = rtt;
+
+            rtts[rtt_idx] = rtt;
+            rtt_idx = (rtt_idx + 1) % ARDUINOOSC_CLOCK_SYNC_WINDOW;
+            if (num_rtts < ARDUINOOSC_CLOCK_SYNC_WINDOW) ++num_rtts;
+            uint32_t min_rtt = rtt;
+            for (size_t i = 0; i < num_rtts; ++i)
+                if (rtts[i] < min_rtt) min_rtt = rtts[i];
+            if (rtt > min_rtt + min_rtt / 4 + ARDUINOOSC_CLOCK_SYNC_JITTER_US) {
+                ++num_rejected;
+                return;
+            }
+
+            Clock& clock = Clock::getInstance();
+            const TimeTag master_now(master_ntp + Clock::usToNtp(rtt / 2));
+            if (!has_synced || !clock.isSet()) {
+                clock.set(master_now);
+                has_synced = true;
+                last_sync_us = t3_us;
+                return;
+            }
+
+            const int64_t offset_us = Clock::ntpToUs((int64_t)(master_now.value() - clock.now().value()));
+            const uint32_t elapsed_us = t3_us - last_sync_us;
+            last_offset_us = offset_us;
+            if ((offset_us > ARDUINOOSC_CLOCK_SYNC_STEP_US) || (offset_us < -ARDUINOOSC_CLOCK_SYNC_STEP_US)) {
+                clock.set(master_now);
+            } else {
+                clock.slew(offset_us, interval_us);
+                // half of the rate error observed since the last correction
+                if (elapsed_us > 0)
+                    clock.setDrift(clock.drift() + (int32_t)(offset_us * 1000000000LL / (int64_t)elapsed_us / 2));
+            }
+            last_sync_us = t3_us;
+        }
+    };
+
+}  // namespace osc
+}  // namespace arduino
+
+template <typename S>
+using OscClockSync = arduino::osc::ClockSync<S>;
+
+#endif  // ARDUINOOSC_OSCCLOCKSYNC_H
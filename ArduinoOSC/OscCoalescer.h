@@ -0,0 +1,141 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCCOALESCER_H
+#define ARDUINOOSC_OSCCOALESCER_H
+
+#include <Arduino.h>
+#include <DebugLog.h>
+#include "OscTypes.h"
+#include "OscMessage.h"
+#include "OscMessageView.h"
+
+namespace arduino {
+namespace osc {
+    namespace server {
+
+        using namespace message;
+
+        struct CoalesceSlot {
+            uint16_t index {0};      // index of the subscription in the Dispatcher
+            uint32_t window_us {0};  // 0 means until the end of parse()
+            uint32_t since_us {0};   // when the first message of the window was held
+            uint32_t coalesced {0};  // number of the messages replaced by the newer one
+            bool pending {false};
+            bool is_view {false};
+            Message msg;   // newest message in Message mode
+            Storage data;  // newest raw message in MessageView mode
+            TimeTag time_tag;
+            IPAddress ip;
+            uint16_t port {0};
+        };
+
+        // holds only the newest message of each coalescing subscription, and hands it out
+        // once at the end of parse() (or of the time window) instead of every message
+        class Coalescer {
+            CoalesceList slots;
+            uint32_t num_coalesced {0};
+
+        public:
+            static constexpr uint16_t NO_SLOT {0xFFFF};
+
+            // returns the index of the slot, or NO_SLOT if no more slot is available
+            uint16_t add(const uint16_t index, const uint32_t window_us) {
+                for (size_t i = 0; i < slots.size(); ++i) {
+                    if (slots[i].index == index) {
+                        slots[i].window_us = window_us;
+                        return (uint16_t)i;
+                    }
+                }
+#if ARX_HAVE_LIBSTDCPLUSPLUS < 201103L  // Don't have libstdc++11
+                if (slots.size() >= ARDUINOOSC_MAX_COALESCE_PER_PORT) {
+                    LOG_ERROR(F("too many coalescing subscriptions, max is"), ARDUINOOSC_MAX_COALESCE_PER_PORT);
+                    return NO_SLOT;
+                }
+#endif
+                CoalesceSlot s;
+                s.index = index;
+                s.window_us = window_us;
+                slots.push_back(s);
+                return (uint16_t)(slots.size() - 1);
+            }
+
+            void hold(const uint16_t slot, const Message& m) {
+                CoalesceSlot& s = begin(slot);
+                s.msg = m;
+                s.is_view = false;
+            }
+
+            // the viewed bytes are copied into the slot because the rx buffer is reused after parse()
+            void hold(const uint16_t slot, const MessageView& v) {
+                CoalesceSlot& s = begin(slot);
+                s.data.assign(v.data(), v.data() + v.dataSize());
+                s.time_tag = v.timeTag();
+                s.ip = v.remoteIP();
+                s.port = v.remotePort();
+                s.is_view = true;
+            }
+
+            // calls fm(index, Message&) or fv(index, const MessageView&) for the newest message of every slot
+            // whose window is over (the slot with no window is always due)
+            template <typename FM, typename FV>
+            size_t dispatchDue(FM&& fm, FV&& fv) {
+                return dispatch(false, fm, fv);
+            }
+
+            // calls the callbacks for every held message even if the window is not over
+            template <typename FM, typename FV>
+            size_t dispatchAll(FM&& fm, FV&& fv) {
+                return dispatch(true, fm, fv);
+            }
+
+            // total number of the messages replaced by the newer one (not passed to the callbacks)
+            uint32_t coalesced() const { return num_coalesced; }
+            void resetCoalesced() {
+                num_coalesced = 0;
+                for (auto& s : slots) s.coalesced = 0;
+            }
+
+            const CoalesceList& getSlots() const { return slots; }
+            size_t size() const { return slots.size(); }
+            bool empty() const { return slots.empty(); }
+
+        private:
+            CoalesceSlot& begin(const uint16_t slot) {
+                CoalesceSlot& s = slots[slot];
+                if (s.pending) {
+                    ++s.coalesced;
+                    ++num_coalesced;
+                } else {
+                    s.pending = true;
+                    s.since_us = micros();
+                }
+                return s;
+            }
+
+            template <typename FM, typename FV>
+            size_t dispatch(const bool force, FM& fm, FV& fv) {
+                size_t n = 0;
+                const uint32_t now_us = micros();
+                for (auto& s : slots) {
+                    if (!s.pending) continue;
+                    if (!force && s.window_us && ((uint32_t)(now_us - s.since_us) < s.window_us)) continue;
+                    s.pending = false;
+                    if (s.is_view) {
+                        MessageView v(s.data.begin(), s.data.size(), s.time_tag);
+                        v.remoteIP(s.ip);
+                        v.remotePort(s.port);
+                        if (v.available()) fv(s.index, v);
+                    } else {
+                        fm(s.index, s.msg);
+                    }
+                    ++n;
+                }
+                return n;
+            }
+        };
+
+    }  // namespace server
+}  // namespace osc
+}  // namespace arduino
+
+#endif  // ARDUINOOSC_OSCCOALESCER_H
@@ -7,30 +7,30 @@
 #include <DebugLog.h>
 #include "OscTypes.h"
 #include "OscMessage.h"
+#include "OscMessageView.h"
 
 namespace arduino {
 namespace osc {
     namespace message {
 
         class Decoder {
-            using MessageIterator = MessageQueue::iterator;
+            // decoded messages are kept and reused for the next packet,
+            // so that their strings and storage are not allocated again
             MessageQueue messages;
-            MessageIterator it_messages;
+            size_t num_messages {0};
+            size_t idx_messages {0};
 
         public:
-            Decoder()
-            : messages(), it_messages(messages.begin()) {}
+            Decoder() {}
 
-            Decoder(const void* ptr, const size_t sz)
-            : messages(), it_messages(messages.begin()) {
+            Decoder(const void* ptr, const size_t sz) {
                 init(ptr, sz);
             }
 
             bool init(const void* ptr, const size_t sz) {
-                messages.clear();
+                num_messages = idx_messages = 0;
                 if ((sz % 4) == 0) {
                     if (parse((const char*)ptr, (const char*)ptr + sz, TimeTag::immediate())) {
-                        it_messages = messages.begin();
                         return true;
                     }
                 }
@@ -39,16 +39,16 @@ namespace osc {
             }
 
             Message* decode() {
-                if (messages.empty()) {
+                if (num_messages == 0) {
                     LOG_ERROR(F("message is empty"));
                     return nullptr;
                 }
-                if (it_messages == messages.end()) {
+                if (idx_messages == num_messages) {
                     LOG_ERROR(F("no more message to decode"));
                     return nullptr;
                 }
 
-                return &*it_messages++;
+                return &messages[idx_messages++];
             }
 
         private:
@@ -77,17 +77,131 @@ namespace osc {
                         return false;
                     }
                 } else {
-                    messages.push_back(Message(beg, end - beg, time_tag));
+                    if (num_messages == messages.size()) {
+#if ARX_HAVE_LIBSTDCPLUSPLUS < 201103L
+                        if (messages.size() >= ARDUINOOSC_MAX_MSG_QUEUE_SIZE) {
+                            LOG_ERROR(F("message queue is full, message is dropped. max size is"), ARDUINOOSC_MAX_MSG_QUEUE_SIZE);
+                            return true;
+                        }
+#endif
+                        messages.push_back(Message());
+                    }
+                    messages[num_messages++].init(beg, end - beg, time_tag);
                 }
 
                 return true;
             }
         };
 
+        // decodes messages in the packet as MessageView without any allocation
+        // the packet buffer must outlive the decoded views
+        class ViewDecoder {
+            struct Frame {
+                const char* pos;
+                const char* end;
+                TimeTag time_tag;
+            };
+
+            const char* packet_beg {nullptr};
+            const char* packet_end {nullptr};
+            Frame frames[ARDUINOOSC_MAX_MSG_BUNDLE_DEPTH];
+            size_t depth {0};
+            bool has_single_message {false};
+            MessageView view;
+
+        public:
+            ViewDecoder() {}
+
+            ViewDecoder(const void* ptr, const size_t sz) {
+                init(ptr, sz);
+            }
+
+            bool init(const void* ptr, const size_t sz) {
+                packet_beg = (const char*)ptr;
+                packet_end = packet_beg + sz;
+                depth = 0;
+                has_single_message = false;
+                view.clear();
+
+                if ((sz % 4) == 0 && sz != 0) {
+                    if (*packet_beg != '#') {
+                        has_single_message = true;
+                        return true;
+                    }
+                    if (isBundle(packet_beg, packet_end)) {
+                        pushFrame(packet_beg, packet_end);
+                        return true;
+                    }
+                    LOG_ERROR(F("bundle header was corrupted"));
+                }
+                LOG_ERROR(F("parse message failed"));
+                return false;
+            }
+
+            // returned view is overwritten by the next decode()
+            MessageView* decode() {
+                if (has_single_message) {
+                    has_single_message = false;
+                    view.init(packet_beg, packet_end - packet_beg, TimeTag::immediate());
+                    return &view;
+                }
+
+                while (depth) {
+                    Frame& f = frames[depth - 1];
+                    if (f.pos == f.end) {
+                        --depth;
+                        continue;
+                    }
+                    if (f.end - f.pos < 4) {
+                        LOG_ERROR(F("bundle data structure was corrupted"));
+                        --depth;
+                        continue;
+                    }
+                    const uint32_t sz = bytes2pod<uint32_t>(f.pos);
+                    const char* const beg = f.pos + 4;
+                    if ((sz & 3) != 0 || beg + sz > f.end || beg + sz < beg) {
+                        LOG_ERROR(F("bundle data structure was corrupted"));
+                        --depth;
+                        continue;
+                    }
+                    f.pos = beg + sz;
+                    if (sz == 0) continue;
+
+                    if (*beg == '#') {
+                        if (!isBundle(beg, beg + sz)) {
+                            LOG_ERROR(F("bundle header was corrupted"));
+                        } else if (depth >= ARDUINOOSC_MAX_MSG_BUNDLE_DEPTH) {
+                            LOG_ERROR(F("bundle nesting is too deep, max depth is"), ARDUINOOSC_MAX_MSG_BUNDLE_DEPTH);
+                        } else {
+                            pushFrame(beg, beg + sz);
+                        }
+                        continue;
+                    }
+
+                    view.init(beg, sz, f.time_tag);
+                    return &view;
+                }
+                return nullptr;
+            }
+
+        private:
+            static bool isBundle(const char* beg, const char* end) {
+                return (end - beg >= 16) && (memcmp(beg, "#bundle\0", 8) == 0);
+            }
+
+            void pushFrame(const char* beg, const char* end) {
+                frames[depth].pos = beg + 16;
+                frames[depth].end = end;
+                frames[depth].time_tag = TimeTag(bytes2pod<uint64_t>(beg + 8));
+                ++depth;
+            }
+        };
+
     }  // namespace message
 }  // namespace osc
 }  // namespace arduino
 
 using OscDecoder = arduino::osc::message::Decoder;
+using OscViewDecoder = arduino::osc::message::ViewDecoder;
 
 #endif  // ARDUINOOSC_OSCDECODER_H
@@ -0,0 +1,147 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCDISPATCHER_H
+#define ARDUINOOSC_OSCDISPATCHER_H
+
+#include <Arduino.h>
+#include <DebugLog.h>
+#include "OscTypes.h"
+#include "OscUtil.h"
+#include "OscPattern.h"
+
+namespace arduino {
+namespace osc {
+    namespace server {
+
+        struct Subscription {
+            String address;
+            ElementRef ref;
+            uint32_t hash;
+            pattern::CompiledPattern pattern;  // compiled at subscribe()
+            uint16_t coalesce_slot {0xFFFF};   // slot of the Coalescer if only the newest message is dispatched
+#ifdef ARDUINOOSC_ENABLE_STATS
+            uint32_t dispatched {0};  // number of the messages passed to the callback
+#endif
+        };
+
+        // subscribed addresses without wildcards are found by hash in O(address length)
+        // and only the subscriptions with wildcards are matched one by one with the patterns compiled at insert()
+        class Dispatcher {
+            static constexpr uint16_t EMPTY_SLOT {0xFFFF};
+
+            SubscriptionList subscriptions;
+            SubscriptionIndex table;  // open addressing, size is power of 2
+            size_t num_patterns {0};
+
+        public:
+            static uint32_t hash(const char* addr, const size_t len) {
+                return fnv1a(addr, len);
+            }
+
+            static bool isPattern(const char* addr) {
+                return pattern::CompiledPattern::isPattern(addr);
+            }
+
+            // same address is subscribed only once
+            bool insert(const String& addr, const ElementRef& ref) {
+                if (find(addr) != nullptr) {
+                    LOG_ERROR(F("address is already subscribed:"), addr);
+                    return false;
+                }
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+                if (subscriptions.size() >= EMPTY_SLOT) {
+#else
+                if (subscriptions.size() >= ARDUINOOSC_MAX_SUBSCRIBE_ADDRESS_PER_PORT) {
+#endif
+                    LOG_ERROR(F("too many subscriptions"));
+                    return false;
+                }
+
+                Subscription s;
+                s.address = addr;
+                s.ref = ref;
+                s.hash = hash(addr.c_str(), addr.length());
+                s.pattern.compile(addr.c_str());
+                subscriptions.push_back(s);
+                if (!s.pattern.isLiteral()) ++num_patterns;
+                rebuild();
+                return true;
+            }
+
+            Subscription* find(const String& addr) {
+                for (auto& s : subscriptions)
+                    if (s.address == addr) return &s;
+                return nullptr;
+            }
+
+            // index of the subscription (subscriptions are never removed), or size() if not found
+            size_t indexOf(const String& addr) const {
+                for (size_t i = 0; i < subscriptions.size(); ++i)
+                    if (subscriptions[i].address == addr) return i;
+                return subscriptions.size();
+            }
+            Subscription& operator[](const size_t i) { return subscriptions[i]; }
+
+            // calls f(Subscription&) for every subscription which matches to the address
+            // addr must be null-terminated (len is excluding the terminator)
+            // the exact-match subscription is called first, and then the pattern ones
+            template <typename F>
+            size_t dispatch(const char* addr, const size_t len, F&& f) {
+                size_t n = 0;
+                if (!table.empty()) {
+                    const uint32_t h = hash(addr, len);
+                    const size_t mask = table.size() - 1;
+                    for (size_t i = h & mask;; i = (i + 1) & mask) {
+                        const uint16_t idx = table[i];
+                        if (idx == EMPTY_SLOT) break;
+                        Subscription& s = subscriptions[idx];
+                        if ((s.hash == h) && (s.address.length() == len) && (memcmp(s.address.c_str(), addr, len) == 0)) {
+                            f(s);
+                            ++n;
+                            break;
+                        }
+                    }
+                }
+                if (num_patterns) {
+                    for (auto& s : subscriptions) {
+                        if (s.pattern.isLiteral()) continue;
+                        if (s.pattern.match(s.address.c_str(), addr, len)) {
+                            f(s);
+                            ++n;
+                        }
+                    }
+                }
+                return n;
+            }
+
+            const SubscriptionList& getSubscriptions() const { return subscriptions; }
+#ifdef ARDUINOOSC_ENABLE_STATS
+            void resetStats() {
+                for (auto& s : subscriptions) s.dispatched = 0;
+            }
+#endif
+            size_t size() const { return subscriptions.size(); }
+            bool empty() const { return subscriptions.empty(); }
+
+        private:
+            void rebuild() {
+                size_t sz = 4;
+                while (sz < subscriptions.size() * 2) sz <<= 1;
+                table.clear();
+                for (size_t i = 0; i < sz; ++i) table.push_back(EMPTY_SLOT);
+                const size_t mask = sz - 1;
+                for (size_t idx = 0; idx < subscriptions.size(); ++idx) {
+                    const Subscription& s = subscriptions[idx];
+                    if (!s.pattern.isLiteral()) continue;
+                    size_t i = s.hash & mask;
+                    while (table[i] != EMPTY_SLOT) i = (i + 1) & mask;
+                    table[i] = (uint16_t)idx;
+                }
+            }
+        };
+
+    }  // namespace server
+}  // namespace osc
+}  // namespace arduino
+
+#endif  // ARDUINOOSC_OSCDISPATCHER_H
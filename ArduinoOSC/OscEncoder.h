@@ -11,69 +11,133 @@ namespace arduino {
 namespace osc {
     namespace message {
 
-        class Encoder {
-            Storage storage;
+        // Buffer is Storage (growing on STL boards) or StorageSpan (user provided fixed buffer)
+        template <typename Buffer>
+        class BasicEncoder {
+            Buffer storage;
+            bool is_overflow {false};
 
 #ifndef ARDUINOOSC_DISABLE_BUNDLE
-            BundleData bundles;
+            uint32_t bundles[ARDUINOOSC_MAX_MSG_BUNDLE_DEPTH];  // positions of the nested bundles
+            size_t num_bundles {0};
 #endif
 
         public:
-            Encoder() {
+            BasicEncoder() {
+                init();
+            }
+            // only for StorageSpan: encode into the buffer, nothing is allocated
+            BasicEncoder(uint8_t* buf, const size_t size)
+            : storage((char*)buf, size) {
                 init();
             }
 
-            Encoder& init() {
+            BasicEncoder& init() {
                 storage.clear();
+                is_overflow = false;
 #ifndef ARDUINOOSC_DISABLE_BUNDLE
-                bundles.clear();
+                num_bundles = 0;
 #endif
                 return *this;
             }
 
-            Encoder& encode(const Message& msg) {
+            BasicEncoder& encode(const Message& msg) {
 #ifdef ARDUINOOSC_DISABLE_BUNDLE
-                msg.encode(storage, false);
+                if (!msg.encode(storage, false)) is_overflow = true;
 #else
-                msg.encode(storage, !bundles.empty());
+                if (!msg.encode(storage, num_bundles != 0)) is_overflow = true;
+#endif
+                return *this;
+            }
+
+            // encode the message with the pre-encoded header (address and type tags)
+            BasicEncoder& encode(const Blob& header, const Message& msg) {
+#ifndef ARDUINOOSC_DISABLE_BUNDLE
+                if (num_bundles) {
+                    char* p = getBytes(4);
+                    if (!p) return *this;
+                    pod2bytes<uint32_t>(uint32_t(header.size() + msg.argumentsSize()), p);
+                }
 #endif
+                if (header.size()) {
+                    char* p = getBytes(header.size());
+                    if (!p) return *this;
+                    memcpy(p, header.data(), header.size());
+                }
+                if (!msg.encodeArguments(storage)) is_overflow = true;
+                return *this;
+            }
+
+            // append the message which is already encoded (e.g. cached one)
+            BasicEncoder& encode(const uint8_t* msg, const size_t size) {
+#ifndef ARDUINOOSC_DISABLE_BUNDLE
+                if (num_bundles) {
+                    char* p = getBytes(4);
+                    if (!p) return *this;
+                    pod2bytes<uint32_t>(uint32_t(size), p);
+                }
+#endif
+                char* p = getBytes(size);
+                if (p) memcpy(p, msg, size);
                 return *this;
             }
 
             uint32_t size() const { return (uint32_t)storage.size(); }
             const uint8_t* data() const { return (const uint8_t*)storage.begin(); }
+            // true if any data could not be written since init(), the encoded data must be discarded
+            bool overflow() const { return is_overflow; }
 
 #ifndef ARDUINOOSC_DISABLE_BUNDLE
 
-            Encoder& begin_bundle(const TimeTag& ts = TimeTag::immediate()) {
-                char* p;
-                if (bundles.size()) p = storage.getBytes(4);  // hold the bundle size
-                p = storage.getBytes(8);
+            BasicEncoder& begin_bundle(const TimeTag& ts = TimeTag::immediate()) {
+                if (num_bundles >= ARDUINOOSC_MAX_MSG_BUNDLE_DEPTH) {
+                    LOG_ERROR(F("bundle depth overflow, max depth is"), ARDUINOOSC_MAX_MSG_BUNDLE_DEPTH);
+                    is_overflow = true;
+                    return *this;
+                }
+                if (num_bundles && !getBytes(4)) return *this;  // hold the bundle size
+                char* p = getBytes(8);
+                if (!p) return *this;
                 strcpy(p, "#bundle");
-                bundles.push_back(p - storage.begin());
-                p = storage.getBytes(8);
+                bundles[num_bundles++] = p - storage.begin();
+                p = getBytes(8);
+                if (!p) return *this;
                 pod2bytes<uint64_t>(ts, p);
                 return *this;
             }
 
-            Encoder& end_bundle() {
-                if (bundles.size()) {
-                    if (storage.size() - bundles.back() == 16)
-                        pod2bytes<uint32_t>(0, storage.getBytes(4));  // the 'empty bundle' case, not very elegant
-                    if (bundles.size() > 1)
-                        pod2bytes<uint32_t>(uint32_t(storage.size() - bundles.back()), storage.begin() + bundles.back() - 4);
-                    bundles.pop_back();
+            BasicEncoder& end_bundle() {
+                if (num_bundles) {
+                    const uint32_t pos = bundles[num_bundles - 1];
+                    if (storage.size() - pos == 16) {
+                        char* p = getBytes(4);  // the 'empty bundle' case, not very elegant
+                        if (p) pod2bytes<uint32_t>(0, p);
+                    }
+                    if (num_bundles > 1)
+                        pod2bytes<uint32_t>(uint32_t(storage.size() - pos), storage.begin() + pos - 4);
+                    --num_bundles;
                 }
                 return *this;
             }
 
 #endif  // ARDUINOOSC_DISABLE_BUNDLE
+
+        private:
+            char* getBytes(const size_t sz) {
+                char* p = storage.getBytes(sz);
+                if (!p) is_overflow = true;
+                return p;
+            }
         };
 
+        using Encoder = BasicEncoder<Storage>;
+        using SpanEncoder = BasicEncoder<StorageSpan>;
+
     }  // namespace message
 }  // namespace osc
 }  // namespace arduino
 
 using OscEncoder = arduino::osc::message::Encoder;
+using OscSpanEncoder = arduino::osc::message::SpanEncoder;
 
 #endif  // ARDUINOOSC_OSCENCODER_H
@@ -0,0 +1,121 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCFANOUT_H
+#define ARDUINOOSC_OSCFANOUT_H
+
+#include <Arduino.h>
+#include <DebugLog.h>
+#include "OscTypes.h"
+
+// interface of the multicast packets unless it is set to the client or to the endpoint
+// it is looked up at the multicast packet until the link has the address, and cached by the client
+#ifndef ARDUINOOSC_DEFAULT_MULTICAST_IFACE
+#if defined(ARDUINOOSC_ENABLE_ETH)
+#define ARDUINOOSC_DEFAULT_MULTICAST_IFACE() ETH.localIP()
+#elif defined(ARDUINOOSC_ENABLE_ETHER)
+#define ARDUINOOSC_DEFAULT_MULTICAST_IFACE() Ethernet.localIP()
+#elif defined(ARDUINOOSC_ENABLE_WIFI)
+#define ARDUINOOSC_DEFAULT_MULTICAST_IFACE() WiFi.localIP()
+#else
+#define ARDUINOOSC_DEFAULT_MULTICAST_IFACE() IPAddress()
+#endif
+#endif
+
+// registers the static function f() which is called when the link is connected, disconnected or gets the new address
+// the cached interface of the client is looked up again after it, other boards call linkChanged() of the manager
+#ifndef ARDUINOOSC_ON_LINK_CHANGE
+#if defined(ESP_PLATFORM) && defined(ESP_ARDUINO_VERSION_MAJOR) && (ESP_ARDUINO_VERSION_MAJOR >= 2) \
+    && (defined(ARDUINOOSC_ENABLE_ETH) || defined(ARDUINOOSC_ENABLE_WIFI))
+#define ARDUINOOSC_ON_LINK_CHANGE(f) WiFi.onEvent([](arduino_event_id_t, arduino_event_info_t) { f(); })
+#else
+#define ARDUINOOSC_ON_LINK_CHANGE(f)
+#endif
+#endif
+
+namespace arduino {
+namespace osc {
+    namespace client {
+
+        struct FanoutEndpoint {
+            IPAddress ip;
+            uint16_t port {0};
+            bool is_multicast {false};
+            IPAddress iface;  // 0.0.0.0 means the multicast interface of the client
+            mutable uint32_t sent {0};
+            mutable uint32_t failures {0};
+        };
+
+        // group of the endpoints (multicast groups and unicast hosts) which receive the same packet
+        // the packet is encoded once and written to every endpoint, and the addresses are parsed only when added
+        // the group must be alive while it is published
+        class Fanout {
+            FanoutEndpointList endpoints;
+
+        public:
+            // host names are not accepted because they would be resolved for every packet
+            bool add(const String& ip, const uint16_t port) {
+                return add(ip, port, false, IPAddress());
+            }
+            bool addMulticast(const String& ip, const uint16_t port, const IPAddress& iface = IPAddress()) {
+                return add(ip, port, true, iface);
+            }
+
+            bool remove(const String& ip, const uint16_t port) {
+                IPAddress addr;
+                if (!addr.fromString(ip)) return false;
+                for (size_t i = 0; i < endpoints.size(); ++i) {
+                    if ((endpoints[i].ip != addr) || (endpoints[i].port != port)) continue;
+                    for (size_t j = i + 1; j < endpoints.size(); ++j) endpoints[j - 1] = endpoints[j];
+                    endpoints.pop_back();
+                    return true;
+                }
+                return false;
+            }
+            void clear() { endpoints.clear(); }
+
+            // set the interface of all multicast endpoints, e.g. after the link is reconnected
+            void multicastInterface(const IPAddress& iface) {
+                for (auto& e : endpoints)
+                    if (e.is_multicast) e.iface = iface;
+            }
+
+            const FanoutEndpointList& getEndpoints() const { return endpoints; }
+            size_t size() const { return endpoints.size(); }
+            bool empty() const { return endpoints.empty(); }
+
+        private:
+            bool add(const String& ip, const uint16_t port, const bool is_multicast, const IPAddress& iface) {
+                FanoutEndpoint e;
+                if (!e.ip.fromString(ip)) {
+                    LOG_ERROR(F("fanout endpoint must be an ip address:"), ip);
+                    return false;
+                }
+                e.port = port;
+                e.is_multicast = is_multicast;
+                e.iface = iface;
+                for (auto& d : endpoints) {
+                    if ((d.ip == e.ip) && (d.port == e.port)) {
+                        d.is_multicast = is_multicast;
+                        d.iface = iface;
+                        return true;
+                    }
+                }
+#if ARX_HAVE_LIBSTDCPLUSPLUS < 201103L  // Don't have libstdc++11
+                if (endpoints.size() >= ARDUINOOSC_MAX_FANOUT_ENDPOINTS) {
+                    LOG_ERROR(F("too many fanout endpoints, max is"), ARDUINOOSC_MAX_FANOUT_ENDPOINTS);
+                    return false;
+                }
+#endif
+                endpoints.push_back(e);
+                return true;
+            }
+        };
+
+    }  // namespace client
+}  // namespace osc
+}  // namespace arduino
+
+using OscFanout = arduino::osc::client::Fanout;
+using OscFanoutEndpoint = arduino::osc::client::FanoutEndpoint;
+
+#endif  // ARDUINOOSC_OSCFANOUT_H
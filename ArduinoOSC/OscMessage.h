@@ -7,6 +7,7 @@
 #include <DebugLog.h>
 #include "OscTypes.h"
 #include "OscUtil.h"
+#include "OscPattern.h"
 
 namespace arduino {
 namespace osc {
@@ -18,6 +19,86 @@ namespace osc {
         using namespace arx;
 #endif
 
+        namespace detail {
+            // tags which have no argument bytes
+            inline bool is_empty_arg(const int type) {
+                switch (type) {
+                    case TYPE_TAG_TRUE:
+                    case TYPE_TAG_FALSE:
+                    case TYPE_TAG_NIL:
+                    case TYPE_TAG_IMPULSE:
+                    case TYPE_TAG_ARRAY_BEGIN:
+                    case TYPE_TAG_ARRAY_END:
+                        return true;
+                    default:
+                        return false;
+                }
+            }
+
+            // size of the argument which begins at p, or 0 if it does not fit in [p, end)
+            inline size_t arg_size(const int type, const char* const p, const char* const end) {
+                if (is_empty_arg(type)) return 0;
+                size_t sz = 0;
+                switch (type) {
+                    case TYPE_TAG_INT32:
+                    case TYPE_TAG_FLOAT:
+                    case TYPE_TAG_CHAR:
+                    case TYPE_TAG_RGBA:
+                    case TYPE_TAG_MIDI: {
+                        sz = 4;
+                        break;
+                    }
+                    case TYPE_TAG_INT64:
+                    case TYPE_TAG_DOUBLE:
+                    case TYPE_TAG_TIMETAG: {
+                        sz = 8;
+                        break;
+                    }
+                    case TYPE_TAG_STRING: {
+                        if (p >= end) break;
+                        const char* const q = (const char*)memchr(p, 0, end - p);
+                        if (!q) {
+                            LOG_ERROR(F("string is not terminated"));
+                            return 0;
+                        }
+                        sz = (q - p) + 1;
+                        break;
+                    }
+                    case TYPE_TAG_BLOB: {
+                        if (p + 4 > end) break;
+                        sz = 4 + bytes2pod<uint32_t>(p);
+                        break;
+                    }
+                    default: {
+                        return 0;
+                    }
+                }
+                if ((p >= end) ||      // storage pointer is out of range
+                    (p + sz > end) ||  // string or blob too large
+                    (p + sz < p)       // or even blob so large that it did overflow
+                ) {
+                    LOG_ERROR(F("string or blob size is too large"));
+                    return 0;
+                }
+                return sz;
+            }
+
+            // true if the tags [start, start + count) are all floats, so their bytes are contiguous
+            inline bool is_float_run(const char* const tags, const size_t len, const size_t start, const size_t count) {
+                if ((start > len) || (count > len - start)) {
+                    LOG_ERROR(F("index overrun"), start + count, F("must be <="), len);
+                    return false;
+                }
+                for (size_t i = start; i < start + count; ++i) {
+                    if (tags[i] != TYPE_TAG_FLOAT) {
+                        LOG_ERROR(F("type tag is not float:"), tags[i]);
+                        return false;
+                    }
+                }
+                return true;
+            }
+        }  // namespace detail
+
         class Message {
             TimeTag time_tag; // Used only for the received msg in the bundle
             String address_str;
@@ -26,8 +107,11 @@ namespace osc {
             ArgumentQueue arguments;
             bool valid = false;
 
-            String remote_ip;
-            uint16_t remote_port;
+            // the sender is kept as binary and formatted to the string only if remoteIP() is called
+            IPAddress remote_addr;
+            mutable String remote_ip;
+            mutable bool is_remote_ip_formatted {true};
+            uint16_t remote_port {0};
 
         public:
             Message() {
@@ -43,6 +127,7 @@ namespace osc {
             }
             Message(const String& ip, const uint16_t port, const String& addr)
             : remote_ip(ip), remote_port(port) {
+                remote_addr.fromString(ip.c_str());
                 init(addr);
             }
 
@@ -55,25 +140,66 @@ namespace osc {
                 return *this;
             }
 
+            // rebuild from the raw data, the buffers of the message are reused
+            bool init(const void* ptr, const size_t sz, const TimeTag tt = TimeTag::immediate()) {
+                valid = buildFromRawData(ptr, sz);
+                time_tag = tt;
+                return valid;
+            }
+
             bool match(const String& pattern, const bool full = true) const {
                 if (full)
                     return fullPatternMatch(pattern.c_str(), address_str.c_str());
                 else
                     return partialPatternMatch(pattern.c_str(), address_str.c_str());
             }
+            // full match with the precompiled pattern
+            bool match(const Pattern& pattern) const {
+                return pattern.match(address_str);
+            }
 
-            void encode(Storage& s, const bool write_size = false) const {
-                size_t l_addr = address_str.length() + 1;
-                size_t l_type = type_tags.length() + 2;
+            // Buffer is Storage or StorageSpan, returns false if the buffer overflows
+            template <typename Buffer>
+            bool encode(Buffer& s, const bool write_size = false) const {
                 if (write_size) {
-                    uint32_t sz = uint32_t(ceil4(l_addr) + ceil4(l_type) + ceil4(storage.size()));
-                    pod2bytes<uint32_t>(sz, s.getBytes(4));
+                    char* p = s.getBytes(4);
+                    if (!p) return false;
+                    pod2bytes<uint32_t>(uint32_t(encodedSize()), p);
                 }
+                return encodeHeader(s, address_str, type_tags) && encodeArguments(s);
+            }
+
+            // address and type tags with zero padding
+            template <typename Buffer>
+            static bool encodeHeader(Buffer& s, const String& addr, const String& tags) {
+                char* a = s.getBytes(addr.length() + 1);
+                if (!a) return false;
+                memcpy(a, addr.c_str(), addr.length());
+                char* t = s.getBytes(tags.length() + 2);
+                if (!t) return false;
+                t[0] = ',';
+                memcpy(t + 1, tags.c_str(), tags.length());
+                return true;
+            }
+            static size_t headerSize(const String& addr, const String& tags) {
+                return ceil4(addr.length() + 1) + ceil4(tags.length() + 2);
+            }
+
+            template <typename Buffer>
+            bool encodeArguments(Buffer& s) const {
+                if (!storage.size()) return true;
+                char* p = s.getBytes(storage.size());
+                if (!p) return false;
+                memcpy(p, storage.begin(), storage.size());
+                return true;
+            }
+
+            size_t argumentsSize() const { return ceil4(storage.size()); }
+            const char* argumentsData() const { return storage.begin(); }
 
-                strcpy(s.getBytes(l_addr), address_str.c_str());
-                strcpy(s.getBytes(l_type), ("," + type_tags).c_str());
-                if (storage.size())
-                    memcpy(s.getBytes(storage.size()), const_cast<Storage&>(storage).begin(), storage.size());
+            // encoded bytes of the message, excluding the size prefix in the bundle
+            size_t encodedSize() const {
+                return headerSize(address_str, type_tags) + argumentsSize();
             }
 
             bool available() const {
@@ -82,6 +208,12 @@ namespace osc {
 
             void clear() {
                 address_str = type_tags = String("");
+                clearArguments();
+            }
+
+            // keeps the address to push the arguments again
+            void clearArguments() {
+                type_tags = "";
                 storage.clear();
                 arguments.clear();
                 time_tag = TimeTag::immediate();
@@ -96,15 +228,27 @@ namespace osc {
             Message& push(const T& t);
             Message& push(const char* c) { return pushString(String(c)); }
 
-            Message& pushBool(const bool b) {
-                type_tags += (char)(b ? TYPE_TAG_TRUE : TYPE_TAG_FALSE);
-                arguments.push_back(std::make_pair(storage.size(), storage.size()));
-                return *this;
-            }
+            Message& pushBool(const bool b) { return pushEmpty(b ? TYPE_TAG_TRUE : TYPE_TAG_FALSE); }
+            Message& pushNil() { return pushEmpty(TYPE_TAG_NIL); }
+            Message& pushImpulse() { return pushEmpty(TYPE_TAG_IMPULSE); }
+            Message& pushArrayBegin() { return pushEmpty(TYPE_TAG_ARRAY_BEGIN); }
+            Message& pushArrayEnd() { return pushEmpty(TYPE_TAG_ARRAY_END); }
             Message& pushInt32(const int32_t i) { return pushPod(TYPE_TAG_INT32, i); }
             Message& pushInt64(const int64_t h) { return pushPod(TYPE_TAG_INT64, h); }
             Message& pushFloat(const float f) { return pushPod(TYPE_TAG_FLOAT, f); }
             Message& pushDouble(const double d) { return pushPod(TYPE_TAG_DOUBLE, d); }
+            Message& pushTimeTag(const TimeTag& t) { return pushPod(TYPE_TAG_TIMETAG, t.value()); }
+            Message& pushChar(const char c) { return pushPod(TYPE_TAG_CHAR, (int32_t)c); }
+            // 4 bytes from msb: port id, status byte, data1, data2
+            Message& pushMidi(const uint32_t m) { return pushPod(TYPE_TAG_MIDI, m); }
+            // 4 bytes from msb: red, green, blue, alpha
+            Message& pushRgba(const uint32_t c) { return pushPod(TYPE_TAG_RGBA, c); }
+            // floats in the array brackets: [ffff...]
+            Message& pushFloatArray(const float* values, const size_t n) {
+                pushArrayBegin();
+                for (size_t i = 0; i < n; ++i) pushFloat(values[i]);
+                return pushArrayEnd();
+            }
             Message& pushString(const String& s) {
                 type_tags += (char)TYPE_TAG_STRING;
                 arguments.push_back(std::make_pair(storage.size(), s.length() + 1));
@@ -131,12 +275,34 @@ namespace osc {
             int64_t getArgAsInt64(const size_t i) const { return getPod<int64_t>(i); }
             float getArgAsFloat(const size_t i) const { return getPod<float>(i); }
             double getArgAsDouble(const size_t i) const { return getPod<double>(i); }
+            TimeTag getArgAsTimeTag(const size_t i) const { return TimeTag(getPod<uint64_t>(i)); }
+            char getArgAsChar(const size_t i) const { return (char)getPod<int32_t>(i); }
+            uint32_t getArgAsMidi(const size_t i) const { return getPod<uint32_t>(i); }
+            uint32_t getArgAsRgba(const size_t i) const { return getPod<uint32_t>(i); }
             String getArgAsString(const size_t i) const { return String(argBeg(i)); }
             Blob getArgAsBlob(const size_t i) const {
                 Blob b;
                 b.assign(argBeg(i) + 4, argEnd(i));
                 return b;
             }
+            // converts the floats [start, start + count) at once, e.g. the elements of [ffff...]
+            // the tags are checked once and the contiguous bytes are swapped in one loop
+            // returns false (and out is not written) if any of them is not a float
+            bool getArgsAsFloatArray(const size_t start, const size_t count, float* out) const {
+                if (!detail::is_float_run(type_tags.c_str(), type_tags.length(), start, count)) return false;
+                if (count) bytes2pods<float>(storage.begin() + arguments[start].first, out, count);
+                return true;
+            }
+            // points into the storage of the message, no copy
+            const uint8_t* getArgAsBlobPtr(const size_t i, size_t& num_bytes) const {
+                const char* p = argBeg(i);
+                if (!p) {
+                    num_bytes = 0;
+                    return nullptr;
+                }
+                num_bytes = bytes2pod<uint32_t>(p);
+                return (const uint8_t*)(p + 4);
+            }
             bool getArgAsBool(const size_t i) const {
                 if (getTypeTag(i) == TYPE_TAG_TRUE)
                     return true;
@@ -156,6 +322,14 @@ namespace osc {
             bool isDouble(const size_t i) const { return getTypeTag(i) == TYPE_TAG_DOUBLE; }
             bool isStr(const size_t i) const { return getTypeTag(i) == TYPE_TAG_STRING; }
             bool isBlob(const size_t i) const { return getTypeTag(i) == TYPE_TAG_BLOB; }
+            bool isTimeTag(const size_t i) const { return getTypeTag(i) == TYPE_TAG_TIMETAG; }
+            bool isChar(const size_t i) const { return getTypeTag(i) == TYPE_TAG_CHAR; }
+            bool isMidi(const size_t i) const { return getTypeTag(i) == TYPE_TAG_MIDI; }
+            bool isRgba(const size_t i) const { return getTypeTag(i) == TYPE_TAG_RGBA; }
+            bool isNil(const size_t i) const { return getTypeTag(i) == TYPE_TAG_NIL; }
+            bool isImpulse(const size_t i) const { return getTypeTag(i) == TYPE_TAG_IMPULSE; }
+            bool isArrayBegin(const size_t i) const { return getTypeTag(i) == TYPE_TAG_ARRAY_BEGIN; }
+            bool isArrayEnd(const size_t i) const { return getTypeTag(i) == TYPE_TAG_ARRAY_END; }
 
             const String& typeTags() const { return type_tags; }
             int getTypeTag(const size_t i) const { return type_tags[i]; }
@@ -167,12 +341,26 @@ namespace osc {
             const String& address() const { return address_str; }
             size_t size() const { return type_tags.length(); }
 
-            void remoteIP(const String& addr) { remote_ip = addr; }
-            void remoteIP(const IPAddress& addr) { remote_ip = String(addr[0]) + "." + String(addr[1]) + "." + String(addr[2]) + "." + String(addr[3]); }
-            void remoteIP(const char* addr) { remote_ip = String(addr); }
+            void remoteIP(const String& addr) {
+                remote_ip = addr;
+                remote_addr.fromString(addr.c_str());
+                is_remote_ip_formatted = true;
+            }
+            void remoteIP(const IPAddress& addr) {
+                remote_addr = addr;
+                is_remote_ip_formatted = false;
+            }
+            void remoteIP(const char* addr) { remoteIP(String(addr)); }
             void remotePort(const uint16_t p) { remote_port = p; }
 
-            const String& remoteIP() const { return remote_ip; }
+            const String& remoteIP() const {
+                if (!is_remote_ip_formatted) {
+                    remote_ip = String(remote_addr[0]) + "." + String(remote_addr[1]) + "." + String(remote_addr[2]) + "." + String(remote_addr[3]);
+                    is_remote_ip_formatted = true;
+                }
+                return remote_ip;
+            }
+            const IPAddress& remoteAddress() const { return remote_addr; }
             uint16_t remotePort() const { return remote_port; }
 
             TimeTag timeTag() const { return time_tag; }
@@ -184,9 +372,9 @@ namespace osc {
         private:
             bool buildFromRawData(const void* ptr, const size_t sz) {
                 clear();
-                storage.assign((const char*)ptr, (const char*)ptr + sz);
-                const char* const address_beg = storage.begin();
-                const char* const address_end = (const char*)memchr(address_beg, 0, storage.end() - address_beg);
+                const char* const address_beg = (const char*)ptr;
+                const char* const raw_end = address_beg + sz;
+                const char* const address_end = sz ? (const char*)memchr(address_beg, 0, sz) : nullptr;
 
                 if (!address_end) {
                     LOG_ERROR(F("storage size is too small"));
@@ -197,14 +385,8 @@ namespace osc {
                     return false;
                 }
 
-                address_str = String("");
-                const char* p = address_beg;
-                while (p != address_end) {
-                    address_str += *p++;
-                };
-
                 const char* const type_tags_beg = ceil4(address_end + 1 - address_beg) + address_beg;
-                const char* type_tags_end = (const char*)memchr(type_tags_beg, 0, storage.end() - type_tags_beg);
+                const char* const type_tags_end = (type_tags_beg < raw_end) ? (const char*)memchr(type_tags_beg, 0, raw_end - type_tags_beg) : nullptr;
                 if (!type_tags_end) {
                     LOG_ERROR(F("storage size is too small"));
                     return false;
@@ -214,14 +396,29 @@ namespace osc {
                     return false;
                 }
 
-                type_tags = String("");
-                p = type_tags_beg + 1;  // we do not copy the initial ','
-                while (p != type_tags_end) type_tags += *p++;
+                // both are null-terminated in the packet
+                address_str = address_beg;
+                type_tags = type_tags_beg + 1;  // we do not copy the initial ','
 
-                const char* arg = ceil4(type_tags_end + 1 - address_beg) + address_beg;
+                // only the arguments are copied to the storage
+                const char* const args_beg = ceil4(type_tags_end + 1 - address_beg) + address_beg;
+                if (args_beg < raw_end)
+                    storage.assign(args_beg, raw_end);
+
+#if ARX_HAVE_LIBSTDCPLUSPLUS < 201103L  // Don't have libstdc++11
+                if (type_tags.length() > ARDUINOOSC_MAX_MSG_ARGUMENT_SIZE) {
+                    LOG_ERROR(F("too many arguments:"), type_tags.length(), F("must be <="), ARDUINOOSC_MAX_MSG_ARGUMENT_SIZE);
+                    return false;
+                }
+#endif
+                const char* arg = storage.begin();
                 size_t iarg = 0;
                 while (iarg < type_tags.length()) {
                     size_t len = getArgSize(type_tags[iarg], arg);
+                    if (!len && !detail::is_empty_arg(type_tags[iarg])) {
+                        LOG_ERROR(F("unsupported type tag or corrupted argument"), type_tags[iarg]);
+                        return false;
+                    }
                     arguments.push_back(std::make_pair((size_t)(arg - storage.begin()), len));
                     arg += ceil4(len);
                     ++iarg;
@@ -259,50 +456,17 @@ namespace osc {
             }
 
             size_t getArgSize(const int type, const char* const p) const {
-                if ((p < storage.begin()) || (p >= storage.end())) {
+                if ((p < storage.begin()) || (p > storage.end())) {
                     LOG_ERROR(F("storage pointer is out of range"));
                     return 0;
                 }
+                return detail::arg_size(type, p, storage.end());
+            }
 
-                size_t sz = 0;
-                switch (type) {
-                    case TYPE_TAG_TRUE:
-                    case TYPE_TAG_FALSE: {
-                        sz = 0;
-                        break;
-                    }
-                    case TYPE_TAG_INT32:
-                    case TYPE_TAG_FLOAT: {
-                        sz = 4;
-                        break;
-                    }
-                    case TYPE_TAG_INT64:
-                    case TYPE_TAG_DOUBLE: {
-                        sz = 8;
-                        break;
-                    }
-                    case TYPE_TAG_STRING: {
-                        const char* const q = (const char*)memchr(p, 0, storage.end() - p);
-                        sz = (q - p) + 1;
-                        break;
-                    }
-                    case TYPE_TAG_BLOB: {
-                        sz = 4 + bytes2pod<uint32_t>(p);
-                        break;
-                    }
-                    default: {
-                        return 0;
-                        break;
-                    }
-                }
-                if ((p + sz > storage.end()) ||  // string or blob too large
-                    (p + sz < p)                 // or even blob so large that it did overflow
-                ) {
-                    LOG_ERROR(F("string or blob size is too large"));
-                    return 0;
-                }
-
-                return sz;
+            Message& pushEmpty(const int tag) {
+                type_tags += (char)tag;
+                arguments.push_back(std::make_pair(storage.size(), (size_t)0));
+                return *this;
             }
 
             template <typename POD>
@@ -346,6 +510,8 @@ namespace osc {
         inline String Message::arg<String>(const uint8_t i) const { return getArgAsString(i); }
         template <>
         inline Blob Message::arg<Blob>(const uint8_t i) const { return getArgAsBlob(i); }
+        template <>
+        inline TimeTag Message::arg<TimeTag>(const uint8_t i) const { return getArgAsTimeTag(i); }
 
         template <>
         inline Message& Message::push<bool>(const bool& t) { return pushBool(t); }
@@ -379,6 +545,8 @@ namespace osc {
         inline Message& Message::push<String>(const String& t) { return pushString(t); }
         template <>
         inline Message& Message::push<Blob>(const Blob& t) { return pushBlob(t); }
+        template <>
+        inline Message& Message::push<TimeTag>(const TimeTag& t) { return pushTimeTag(t); }
 
     }  // namespace message
 }  // namespace osc
@@ -0,0 +1,305 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCMESSAGEVIEW_H
+#define ARDUINOOSC_OSCMESSAGEVIEW_H
+
+#include <Arduino.h>
+#include <DebugLog.h>
+#include "OscTypes.h"
+#include "OscUtil.h"
+#include "OscMessage.h"
+
+namespace arduino {
+namespace osc {
+    namespace message {
+
+        // non-owning view of an osc message inside of the received packet buffer
+        // address, type tags and arguments are read directly from the buffer,
+        // so the buffer must outlive the view
+        class MessageView {
+            const char* data_beg {nullptr};
+            size_t data_size {0};
+            const char* address_beg {nullptr};
+            size_t address_len {0};
+            const char* type_tags_beg {nullptr};  // without the initial ','
+            size_t type_tags_len {0};
+            const char* args_beg {nullptr};
+            TimeTag time_tag;  // Used only for the received msg in the bundle
+            bool valid = false;
+
+            IPAddress remote_ip;
+            uint16_t remote_port {0};
+
+            // arguments are located by walking the type tags from the last accessed one,
+            // so that the sequential access is O(1) without storing the offset table
+            mutable size_t cursor_idx {0};
+            mutable const char* cursor_ptr {nullptr};
+
+        public:
+            MessageView() {}
+            MessageView(const void* ptr, const size_t sz, const TimeTag tt = TimeTag::immediate()) {
+                init(ptr, sz, tt);
+            }
+
+            bool init(const void* ptr, const size_t sz, const TimeTag tt = TimeTag::immediate()) {
+                clear();
+                data_beg = (const char*)ptr;
+                data_size = sz;
+                time_tag = tt;
+                valid = parse();
+                return valid;
+            }
+
+            void clear() {
+                data_beg = address_beg = type_tags_beg = args_beg = cursor_ptr = nullptr;
+                data_size = address_len = type_tags_len = cursor_idx = 0;
+                time_tag = TimeTag::immediate();
+                valid = false;
+            }
+
+            bool match(const String& pattern, const bool full = true) const {
+                return match(pattern.c_str(), full);
+            }
+            bool match(const char* pattern, const bool full = true) const {
+                if (!valid) return false;
+                const char* q = internalPatternMatch(pattern, address_beg);
+                return full ? (q && (*q == 0)) : (q != 0);
+            }
+            bool match(const Pattern& pattern) const {
+                return valid && pattern.match(address_beg, address_len);
+            }
+
+            bool available() const {
+                return valid;
+            }
+
+            // copy the viewed message into the owning Message
+            Message toMessage() const {
+                Message m(data_beg, data_size, time_tag);
+                m.remoteIP(remote_ip);
+                m.remotePort(remote_port);
+                return m;
+            }
+
+            ////////////////////////////////////////////
+            // ---------- argument getters ---------- //
+            ////////////////////////////////////////////
+
+            template <typename T>
+            T arg(const uint8_t i) const;
+
+            int32_t getArgAsInt32(const size_t i) const { return getPod<int32_t>(i); }
+            int64_t getArgAsInt64(const size_t i) const { return getPod<int64_t>(i); }
+            float getArgAsFloat(const size_t i) const { return getPod<float>(i); }
+            double getArgAsDouble(const size_t i) const { return getPod<double>(i); }
+            TimeTag getArgAsTimeTag(const size_t i) const { return TimeTag(getPod<uint64_t>(i)); }
+            char getArgAsChar(const size_t i) const { return (char)getPod<int32_t>(i); }
+            uint32_t getArgAsMidi(const size_t i) const { return getPod<uint32_t>(i); }
+            uint32_t getArgAsRgba(const size_t i) const { return getPod<uint32_t>(i); }
+            String getArgAsString(const size_t i) const { return String(argBeg(i)); }
+            // points into the packet buffer, no copy
+            const char* getArgAsCString(const size_t i) const { return argBeg(i); }
+            Blob getArgAsBlob(const size_t i) const {
+                Blob b;
+                const char* p = argBeg(i);
+                if (p) b.assign(p + 4, argEnd(i));
+                return b;
+            }
+            // points into the packet buffer, no copy
+            const uint8_t* getArgAsBlobPtr(const size_t i, size_t& num_bytes) const {
+                const char* p = argBeg(i);
+                if (!p) {
+                    num_bytes = 0;
+                    return nullptr;
+                }
+                num_bytes = bytes2pod<uint32_t>(p);
+                return (const uint8_t*)(p + 4);
+            }
+            // converts the floats [start, start + count) at once, e.g. the elements of [ffff...]
+            // the first one is located by the cursor, and the contiguous bytes are swapped in one loop
+            // returns false (and out is not written) if any of them is not a float
+            bool getArgsAsFloatArray(const size_t start, const size_t count, float* out) const {
+                if (!detail::is_float_run(type_tags_beg, type_tags_len, start, count)) return false;
+                if (count) bytes2pods<float>(argBeg(start), out, count);
+                return true;
+            }
+            bool getArgAsBool(const size_t i) const {
+                if (getTypeTag(i) == TYPE_TAG_TRUE)
+                    return true;
+                else if (getTypeTag(i) == TYPE_TAG_FALSE)
+                    return false;
+                return false;
+            }
+
+            //////////////////////////////////////////////////
+            // ---------- argument type checkers ---------- //
+            //////////////////////////////////////////////////
+
+            bool isBool(const size_t i) const { return getTypeTag(i) == TYPE_TAG_TRUE || getTypeTag(i) == TYPE_TAG_FALSE; }
+            bool isInt32(const size_t i) const { return getTypeTag(i) == TYPE_TAG_INT32; }
+            bool isInt64(const size_t i) const { return getTypeTag(i) == TYPE_TAG_INT64; }
+            bool isFloat(const size_t i) const { return getTypeTag(i) == TYPE_TAG_FLOAT; }
+            bool isDouble(const size_t i) const { return getTypeTag(i) == TYPE_TAG_DOUBLE; }
+            bool isStr(const size_t i) const { return getTypeTag(i) == TYPE_TAG_STRING; }
+            bool isBlob(const size_t i) const { return getTypeTag(i) == TYPE_TAG_BLOB; }
+            bool isTimeTag(const size_t i) const { return getTypeTag(i) == TYPE_TAG_TIMETAG; }
+            bool isChar(const size_t i) const { return getTypeTag(i) == TYPE_TAG_CHAR; }
+            bool isMidi(const size_t i) const { return getTypeTag(i) == TYPE_TAG_MIDI; }
+            bool isRgba(const size_t i) const { return getTypeTag(i) == TYPE_TAG_RGBA; }
+            bool isNil(const size_t i) const { return getTypeTag(i) == TYPE_TAG_NIL; }
+            bool isImpulse(const size_t i) const { return getTypeTag(i) == TYPE_TAG_IMPULSE; }
+            bool isArrayBegin(const size_t i) const { return getTypeTag(i) == TYPE_TAG_ARRAY_BEGIN; }
+            bool isArrayEnd(const size_t i) const { return getTypeTag(i) == TYPE_TAG_ARRAY_END; }
+
+            const char* typeTags() const { return type_tags_beg ? type_tags_beg : ""; }
+            int getTypeTag(const size_t i) const { return (i < type_tags_len) ? type_tags_beg[i] : 0; }
+
+            ///////////////////////////////////////////////////
+            // ---------- osc message information ---------- //
+            ///////////////////////////////////////////////////
+
+            const char* address() const { return address_beg ? address_beg : ""; }
+            size_t addressLength() const { return address_len; }
+            size_t size() const { return type_tags_len; }
+
+            const char* data() const { return data_beg; }
+            size_t dataSize() const { return data_size; }
+            const char* argumentsData() const { return args_beg; }
+
+            void remoteIP(const IPAddress& addr) { remote_ip = addr; }
+            void remotePort(const uint16_t p) { remote_port = p; }
+
+            const IPAddress& remoteIP() const { return remote_ip; }
+            uint16_t remotePort() const { return remote_port; }
+
+            TimeTag timeTag() const { return time_tag; }
+
+        private:
+            bool parse() {
+                const char* const end = data_beg + data_size;
+                if (!data_beg || !data_size) {
+                    LOG_ERROR(F("storage size is too small"));
+                    return false;
+                }
+                address_beg = data_beg;
+                const char* const address_end = (const char*)memchr(address_beg, 0, end - address_beg);
+                if (!address_end) {
+                    LOG_ERROR(F("storage size is too small"));
+                    return false;
+                }
+                if (address_beg[0] != '/') {
+                    LOG_ERROR(F("first letter of packet must be / but it was"), address_beg[0]);
+                    return false;
+                }
+                address_len = address_end - address_beg;
+
+                const char* const type_tags_head = ceil4(address_end + 1 - data_beg) + data_beg;
+                if (type_tags_head >= end) {
+                    LOG_ERROR(F("storage size is too small"));
+                    return false;
+                }
+                const char* const type_tags_end = (const char*)memchr(type_tags_head, 0, end - type_tags_head);
+                if (!type_tags_end) {
+                    LOG_ERROR(F("storage size is too small"));
+                    return false;
+                }
+                if (type_tags_head[0] != ',') {
+                    LOG_ERROR(F("first letter of type tag must be \',\' but it was"), type_tags_head[0]);
+                    return false;
+                }
+                type_tags_beg = type_tags_head + 1;  // we do not expose the initial ','
+                type_tags_len = type_tags_end - type_tags_beg;
+
+                args_beg = ceil4(type_tags_end + 1 - data_beg) + data_beg;
+                const char* arg = args_beg;
+                for (size_t i = 0; i < type_tags_len; ++i) {
+                    const int type = type_tags_beg[i];
+                    const size_t len = detail::arg_size(type, arg, end);
+                    if (!len && !detail::is_empty_arg(type)) {
+                        LOG_ERROR(F("unsupported type tag or corrupted argument"), (char)type);
+                        return false;
+                    }
+                    arg += ceil4(len);
+                }
+                if (arg != end) {
+                    LOG_ERROR(F("address mismatch: estimated end and storage end are"),
+                        (int)(arg - data_beg), "and", (int)data_size);
+                    return false;
+                }
+
+                cursor_idx = 0;
+                cursor_ptr = args_beg;
+                return true;
+            }
+
+            const char* argBeg(const size_t idx) const {
+                if (idx >= type_tags_len) {
+                    LOG_ERROR(F("index overrun"), idx, F("must be <"), type_tags_len);
+                    return 0;
+                }
+                if (idx < cursor_idx) {
+                    cursor_idx = 0;
+                    cursor_ptr = args_beg;
+                }
+                while (cursor_idx < idx) {
+                    cursor_ptr += ceil4(detail::arg_size(type_tags_beg[cursor_idx], cursor_ptr, data_beg + data_size));
+                    ++cursor_idx;
+                }
+                return cursor_ptr;
+            }
+
+            const char* argEnd(const size_t idx) const {
+                const char* p = argBeg(idx);
+                if (!p) return 0;
+                return p + detail::arg_size(type_tags_beg[idx], p, data_beg + data_size);
+            }
+
+            template <typename POD>
+            POD getPod(const size_t idx) const {
+                const char* p = argBeg(idx);
+                return p ? bytes2pod<POD>(p) : POD();
+            }
+        };
+
+        template <>
+        inline bool MessageView::arg<bool>(const uint8_t i) const { return getArgAsBool(i); }
+        template <>
+        inline char MessageView::arg<char>(const uint8_t i) const { return (char)getPod<int32_t>(i); }
+        template <>
+        inline signed char MessageView::arg<signed char>(const uint8_t i) const { return (signed char)getPod<int32_t>(i); }
+        template <>
+        inline unsigned char MessageView::arg<unsigned char>(const uint8_t i) const { return (unsigned char)getPod<int32_t>(i); }
+        template <>
+        inline short MessageView::arg<short>(const uint8_t i) const { return (short)getPod<int32_t>(i); }
+        template <>
+        inline unsigned short MessageView::arg<unsigned short>(const uint8_t i) const { return (unsigned short)getPod<int32_t>(i); }
+        template <>
+        inline int MessageView::arg<int>(const uint8_t i) const { return (int)getPod<int32_t>(i); }
+        template <>
+        inline unsigned MessageView::arg<unsigned>(const uint8_t i) const { return (unsigned)getPod<int32_t>(i); }
+        template <>
+        inline long MessageView::arg<long>(const uint8_t i) const { return (long)getPod<int32_t>(i); }
+        template <>
+        inline unsigned long MessageView::arg<unsigned long>(const uint8_t i) const { return (unsigned long)getPod<int32_t>(i); }
+        template <>
+        inline long long MessageView::arg<long long>(const uint8_t i) const { return (long long)getPod<int64_t>(i); }
+        template <>
+        inline unsigned long long MessageView::arg<unsigned long long>(const uint8_t i) const { return (unsigned long long)getPod<int64_t>(i); }
+        template <>
+        inline float MessageView::arg<float>(const uint8_t i) const { return getPod<float>(i); }
+        template <>
+        inline double MessageView::arg<double>(const uint8_t i) const { return getPod<double>(i); }
+        template <>
+        inline String MessageView::arg<String>(const uint8_t i) const { return getArgAsString(i); }
+        template <>
+        inline Blob MessageView::arg<Blob>(const uint8_t i) const { return getArgAsBlob(i); }
+        template <>
+        inline TimeTag MessageView::arg<TimeTag>(const uint8_t i) const { return getArgAsTimeTag(i); }
+
+    }  // namespace message
+}  // namespace osc
+}  // namespace arduino
+
+using OscMessageView = arduino::osc::message::MessageView;
+
+#endif  // ARDUINOOSC_OSCMESSAGEVIEW_H
@@ -0,0 +1,317 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCPATTERN_H
+#define ARDUINOOSC_OSCPATTERN_H
+
+#include <Arduino.h>
+#include "OscTypes.h"
+#include "OscUtil.h"
+
+// patterns are compiled by default if STL is available, and optionally on NO-STL boards
+// because the tokens are stored in every subscription
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+#ifndef ARDUINOOSC_ENABLE_PATTERN_COMPILE
+#define ARDUINOOSC_ENABLE_PATTERN_COMPILE
+#endif
+#endif
+
+namespace arduino {
+namespace osc {
+    namespace pattern {
+
+        enum class TokenType : uint8_t {
+            LITERAL,     // run of characters compared by memcmp
+            ANY_CHAR,    // '?'
+            CHAR_CLASS,  // [a-z], [!abc]
+            WILDCARD,    // '*' inside of one address part
+            SUPER,       // '//', any number of address parts
+            BRACE,       // {foo,bar,baz}, the first matched alternative is taken
+        };
+
+        // offset and length point to the source pattern (the alternatives without braces for BRACE)
+        struct Token {
+            TokenType type;
+            uint8_t index;  // index of CharClassList for CHAR_CLASS
+            uint16_t offset;
+            uint16_t length;
+        };
+
+        struct CharClass {
+            uint8_t bits[32];
+            bool test(const char c) const {
+                const uint8_t u = (uint8_t)c;
+                return bits[u >> 3] & (1 << (u & 7));
+            }
+        };
+
+        // pattern parsed once into tokens and matched without recursion
+        // tokens refer to the source by offset, so the source is passed again to match()
+        // the pattern which cannot be compiled (syntax error or the lack of the capacity on NO-STL boards)
+        // is matched by internalPatternMatch() as before
+        class CompiledPattern {
+            static constexpr size_t MAX_WILDCARDS {8};  // more '*' and '//' are matched by internalPatternMatch()
+
+#ifdef ARDUINOOSC_ENABLE_PATTERN_COMPILE
+            TokenList tokens;
+            CharClassList classes;
+            uint8_t num_wildcards {0};
+#endif
+            bool is_literal {true};
+            bool is_compiled {false};
+
+        public:
+            static bool isPattern(const char* addr) {
+                for (const char* p = addr; *p; ++p) {
+                    switch (*p) {
+                        case '?':
+                        case '*':
+                        case '[':
+                        case '{':
+                            return true;
+                        case '/':
+                            if (p[1] == '/') return true;
+                            break;
+                        default:
+                            break;
+                    }
+                }
+                return false;
+            }
+
+            bool compile(const char* src) {
+                is_literal = !isPattern(src);
+#ifdef ARDUINOOSC_ENABLE_PATTERN_COMPILE
+                tokens.clear();
+                classes.clear();
+                num_wildcards = 0;
+                is_compiled = is_literal || (parse(src));
+                if (!is_compiled) {
+                    tokens.clear();
+                    classes.clear();
+                }
+#else
+                is_compiled = is_literal;
+#endif
+                return is_compiled;
+            }
+
+            bool isLiteral() const { return is_literal; }
+            bool isCompiled() const { return is_compiled; }
+
+            // full match of the path (len is excluding the terminator)
+            bool match(const char* src, const char* path, const size_t len) const {
+                if (is_literal) return (strlen(src) == len) && (memcmp(src, path, len) == 0);
+                if (!is_compiled) {
+                    const char* q = internalPatternMatch(src, path);
+                    return q && (*q == 0);
+                }
+#ifdef ARDUINOOSC_ENABLE_PATTERN_COMPILE
+                // backtracking points of '*' and '//', the latest one is advanced first
+                struct Point {
+                    size_t ti;  // token after '*' or '//'
+                    size_t pi;
+                };
+                Point points[MAX_WILDCARDS];
+                size_t num_points = 0;
+                size_t ti = 0, pi = 0;
+                const size_t n = tokens.size();
+
+                while (true) {
+                    bool ok = false;
+                    if (ti == n) {
+                        if (pi == len) return true;
+                    } else {
+                        const Token& t = tokens[ti];
+                        switch (t.type) {
+                            case TokenType::LITERAL:
+                                ok = (len - pi >= t.length) && (memcmp(src + t.offset, path + pi, t.length) == 0);
+                                if (ok) pi += t.length;
+                                break;
+                            case TokenType::ANY_CHAR:
+                                ok = (pi < len);
+                                if (ok) ++pi;
+                                break;
+                            case TokenType::CHAR_CLASS:
+                                ok = (pi < len) && classes[t.index].test(path[pi]);
+                                if (ok) ++pi;
+                                break;
+                            case TokenType::BRACE: {
+                                const char* alt = src + t.offset;
+                                const char* end = alt + t.length;
+                                while (true) {
+                                    const char* q = alt;
+                                    while ((q != end) && (*q != ',')) ++q;
+                                    const size_t sz = q - alt;
+                                    if ((len - pi >= sz) && (memcmp(alt, path + pi, sz) == 0)) {
+                                        pi += sz;
+                                        ok = true;
+                                        break;
+                                    }
+                                    if (q == end) break;
+                                    alt = q + 1;
+                                }
+                                break;
+                            }
+                            case TokenType::WILDCARD:
+                            case TokenType::SUPER:
+                                points[num_points].ti = ti + 1;
+                                points[num_points].pi = pi;
+                                ++num_points;
+                                ok = true;
+                                break;
+                        }
+                        if (ok) {
+                            ++ti;
+                            continue;
+                        }
+                    }
+
+                    // '*' takes one more character unless it reaches the end of the address part,
+                    // and '//' restarts from the next '/'
+                    while (num_points) {
+                        Point& pt = points[num_points - 1];
+                        size_t i = pt.pi;
+                        if (tokens[pt.ti - 1].type == TokenType::WILDCARD) {
+                            if ((i < len) && (path[i] != '/')) ++i;
+                            else i = len + 1;
+                        } else {
+                            ++i;
+                            while ((i < len) && (path[i] != '/')) ++i;
+                            if (i >= len) i = len + 1;
+                        }
+                        if (i <= len) {
+                            pt.pi = i;
+                            ti = pt.ti;
+                            pi = i;
+                            break;
+                        }
+                        --num_points;
+                    }
+                    if (!num_points) return false;
+                }
+#else
+                return false;
+#endif
+            }
+
+#ifdef ARDUINOOSC_ENABLE_PATTERN_COMPILE
+        private:
+            bool push(const TokenType type, const size_t offset, const size_t length, const uint8_t index = 0) {
+                if ((offset > 0xFFFF) || (length > 0xFFFF)) return false;
+                if ((type == TokenType::WILDCARD) || (type == TokenType::SUPER)) {
+                    if (num_wildcards >= MAX_WILDCARDS) return false;
+                    ++num_wildcards;
+                }
+#if ARX_HAVE_LIBSTDCPLUSPLUS < 201103L  // Don't have libstdc++11
+                if (tokens.size() >= tokens.capacity()) return false;
+#endif
+                Token t;
+                t.type = type;
+                t.index = index;
+                t.offset = (uint16_t)offset;
+                t.length = (uint16_t)length;
+                tokens.push_back(t);
+                return true;
+            }
+
+            bool pushLiteral(const char* src, const char* beg, const char* end) {
+                if (beg == end) return true;
+                return push(TokenType::LITERAL, beg - src, end - beg);
+            }
+
+            // same syntax as internalPatternMatch(), returns false where it never matches fully
+            bool parse(const char* src) {
+                const char* p = src;
+                const char* lit = p;
+                while (*p) {
+                    if (*p == '?') {
+                        if (!pushLiteral(src, lit, p) || !push(TokenType::ANY_CHAR, 0, 0)) return false;
+                        lit = ++p;
+                    } else if (*p == '[') {
+                        if (!pushLiteral(src, lit, p)) return false;
+                        ++p;
+                        bool reverse = false;
+                        if (*p == '!') {
+                            reverse = true;
+                            ++p;
+                        }
+                        CharClass cc;
+                        memset(cc.bits, 0, sizeof(cc.bits));
+                        for (; *p && (*p != ']'); ++p) {
+                            char c0 = *p, c1 = c0;
+                            if ((p[1] == '-') && p[2]) {
+                                p += 2;
+                                c1 = *p;
+                            }
+                            for (size_t u = 1; u < 256; ++u) {
+                                const char c = (char)u;
+                                if ((c >= c0) && (c <= c1)) cc.bits[u >> 3] |= (1 << (u & 7));
+                            }
+                        }
+                        if (*p != ']') return false;
+                        if (reverse)
+                            for (size_t i = 0; i < sizeof(cc.bits); ++i) cc.bits[i] = ~cc.bits[i];
+#if ARX_HAVE_LIBSTDCPLUSPLUS < 201103L  // Don't have libstdc++11
+                        if (classes.size() >= classes.capacity()) return false;
+#endif
+                        if (classes.size() > 0xFF) return false;
+                        if (!push(TokenType::CHAR_CLASS, 0, 0, (uint8_t)classes.size())) return false;
+                        classes.push_back(cc);
+                        lit = ++p;
+                    } else if (*p == '*') {
+                        if (!pushLiteral(src, lit, p)) return false;
+                        while (*p == '*') ++p;
+                        if (!push(TokenType::WILDCARD, 0, 0)) return false;
+                        lit = p;
+                    } else if ((*p == '/') && (p[1] == '/')) {
+                        if (!pushLiteral(src, lit, p)) return false;
+                        while (p[1] == '/') ++p;
+                        // the last '/' is matched as the literal
+                        if (!push(TokenType::SUPER, 0, 0)) return false;
+                        lit = p++;
+                    } else if (*p == '{') {
+                        if (!pushLiteral(src, lit, p)) return false;
+                        const char* end = strchr(p, '}');
+                        if (!end) return false;
+                        if (!push(TokenType::BRACE, p + 1 - src, end - (p + 1))) return false;
+                        lit = p = end + 1;
+                    } else {
+                        ++p;
+                    }
+                }
+                return pushLiteral(src, lit, p);
+            }
+#endif
+        };
+
+    }  // namespace pattern
+
+    // pattern string with its compiled form, to match many addresses with the same pattern
+    class Pattern {
+        String source;
+        pattern::CompiledPattern compiled;
+
+    public:
+        Pattern() { compiled.compile(""); }
+        explicit Pattern(const char* pattern)
+        : source(pattern) { compiled.compile(source.c_str()); }
+        explicit Pattern(const String& pattern)
+        : source(pattern) { compiled.compile(source.c_str()); }
+
+        const String& str() const { return source; }
+        bool isLiteral() const { return compiled.isLiteral(); }
+
+        bool match(const char* path, const size_t len) const {
+            if (compiled.isLiteral()) return (source.length() == len) && (memcmp(source.c_str(), path, len) == 0);
+            return compiled.match(source.c_str(), path, len);
+        }
+        bool match(const char* path) const { return match(path, strlen(path)); }
+        bool match(const String& path) const { return match(path.c_str(), path.length()); }
+    };
+
+}  // namespace osc
+}  // namespace arduino
+
+using OscPattern = arduino::osc::Pattern;
+
+#endif  // ARDUINOOSC_OSCPATTERN_H
@@ -0,0 +1,402 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCRELIABLE_H
+#define ARDUINOOSC_OSCRELIABLE_H
+
+#include <Arduino.h>
+#include <DebugLog.h>
+#include "OscTypes.h"
+#include "OscUtil.h"
+#include "OscMessage.h"
+#include "OscMessageView.h"
+#include "OscSchema.h"
+
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+#ifndef ARDUINOOSC_RELIABLE_WINDOW
+#define ARDUINOOSC_RELIABLE_WINDOW 8  // unacknowledged packets kept for retransmission
+#endif
+#ifndef ARDUINOOSC_RELIABLE_MAX_PEERS
+#define ARDUINOOSC_RELIABLE_MAX_PEERS 8  // destinations of the sender / senders of the receiver
+#endif
+#else
+#ifndef ARDUINOOSC_RELIABLE_WINDOW
+#define ARDUINOOSC_RELIABLE_WINDOW 2
+#endif
+#ifndef ARDUINOOSC_RELIABLE_MAX_PEERS
+#define ARDUINOOSC_RELIABLE_MAX_PEERS 2
+#endif
+#endif
+#ifndef ARDUINOOSC_RELIABLE_MAX_ADDRESSES
+#define ARDUINOOSC_RELIABLE_MAX_ADDRESSES 4
+#endif
+#ifndef ARDUINOOSC_RELIABLE_TIMEOUT_US
+#define ARDUINOOSC_RELIABLE_TIMEOUT_US 50000  // doubled for every retry
+#endif
+#ifndef ARDUINOOSC_RELIABLE_MAX_RETRIES
+#define ARDUINOOSC_RELIABLE_MAX_RETRIES 5
+#endif
+
+namespace arduino {
+namespace osc {
+    namespace reliable {
+
+        using namespace message;
+
+        // sender -> receiver : ENVELOPE ,iiib (session, sequence number, ack port, encoded message)
+        // receiver -> sender : ACK ,ii (sequence number, receiver port)
+        //                      NACK ,iii (first missing sequence number, count, receiver port)
+        // sequence numbers start from 1 for each destination, and the session changes when the sender restarts
+        // or when the destination was forgotten by the sender, so the receiver does not take the new sequence as old one
+        static constexpr const char* ENVELOPE_ADDRESS {"/rel/msg"};
+        static constexpr const char* ACK_ADDRESS {"/rel/ack"};
+        static constexpr const char* NACK_ADDRESS {"/rel/nack"};
+        static constexpr const char* ENVELOPE_TYPE_TAGS {"iiib"};
+        static constexpr size_t ENVELOPE_NUM_ARGS {4};
+
+        inline bool isEnvelope(const char* addr) { return strcmp(addr, ENVELOPE_ADDRESS) == 0; }
+
+        // keeps the encoded envelopes until they are acknowledged, and resends them on the timeout or NACK
+        class Sender {
+            struct Pending {
+                bool used {false};
+                bool resend {false};
+                uint8_t retries {0};
+                uint32_t seq {0};
+                uint32_t sent_us {0};
+                IPAddress ip;
+                uint16_t port {0};
+                Blob data;
+            };
+            struct Peer {
+                IPAddress ip;
+                uint16_t port {0};
+                uint32_t session {0};
+                uint32_t next_seq {1};
+            };
+
+            Pending slots[ARDUINOOSC_RELIABLE_WINDOW];
+            Peer peers[ARDUINOOSC_RELIABLE_MAX_PEERS];
+            size_t num_peers {0};
+            String addrs[ARDUINOOSC_RELIABLE_MAX_ADDRESSES];
+            size_t num_addrs {0};
+
+            uint32_t next_session {0};
+            uint16_t ack_port {0};
+            uint32_t timeout_us {ARDUINOOSC_RELIABLE_TIMEOUT_US};
+            uint8_t max_retries {ARDUINOOSC_RELIABLE_MAX_RETRIES};
+
+            uint32_t num_sent {0};
+            uint32_t num_acked {0};
+            uint32_t num_retransmitted {0};
+            uint32_t num_given_up {0};
+
+        public:
+            // ACK / NACK are received on ack_port
+            // the sessions are taken from the time of the first begin(), calling it again only changes the port
+            void begin(const uint16_t port) {
+                ack_port = port;
+                if (next_session == 0) next_session = micros() | 1;
+            }
+            uint16_t ackPort() const { return ack_port; }
+
+            // messages to the address are sent reliably by Client::send()
+            bool add(const String& addr) {
+                if (isReliable(addr)) return true;
+                if (num_addrs >= ARDUINOOSC_RELIABLE_MAX_ADDRESSES) {
+                    LOG_ERROR(F("too many reliable addresses, max is"), ARDUINOOSC_RELIABLE_MAX_ADDRESSES);
+                    return false;
+                }
+                addrs[num_addrs++] = addr;
+                return true;
+            }
+            bool remove(const String& addr) {
+                for (size_t i = 0; i < num_addrs; ++i) {
+                    if (addrs[i] != addr) continue;
+                    for (size_t j = i + 1; j < num_addrs; ++j) addrs[j - 1] = addrs[j];
+                    addrs[--num_addrs] = "";
+                    return true;
+                }
+                return false;
+            }
+            bool isReliable(const String& addr) const {
+                for (size_t i = 0; i < num_addrs; ++i)
+                    if (addrs[i] == addr) return true;
+                return false;
+            }
+
+            void setTimeoutUsec(const uint32_t us) { timeout_us = us; }
+            void setMaxRetries(const uint8_t n) { max_retries = n; }
+
+            // wraps the encoded message into the envelope with the next sequence number of the destination
+            // returns 0 if it does not fit in the message, or if all the destinations have pending packets
+            uint32_t wrap(Message& envelope, const IPAddress& ip, const uint16_t port, const uint8_t* data, const size_t size) {
+#if ARX_HAVE_LIBSTDCPLUSPLUS < 201103L  // Don't have libstdc++11
+                if (Message::headerSize(ENVELOPE_ADDRESS, ENVELOPE_TYPE_TAGS) + 16 + ceil4(size) > ARDUINOOSC_MAX_MSG_BYTE_SIZE) {
+                    LOG_ERROR(F("reliable message is too large:"), size);
+                    return 0;
+                }
+#endif
+                Peer* peer = findPeer(ip, port);
+                if (!peer) return 0;
+                const uint32_t seq = peer->next_seq++;
+                envelope.init(ENVELOPE_ADDRESS);
+                envelope.pushInt32((int32_t)peer->session).pushInt32((int32_t)seq).pushInt32((int32_t)ack_port);
+                envelope.pushBlob(data, size);
+                return seq;
+            }
+
+            // keep the encoded envelope, the oldest one is given up if the window is full
+            void hold(const uint32_t seq, const IPAddress& ip, const uint16_t port, const uint8_t* data, const size_t size) {
+                Pending* p = nullptr;
+                for (auto& s : slots) {
+                    if (!s.used) {
+                        p = &s;
+                        break;
+                    }
+                    if (!p || ((int32_t)(s.sent_us - p->sent_us) < 0)) p = &s;
+                }
+                if (p->used) {
+                    LOG_ERROR(F("reliable window is full, gave up seq"), p->seq);
+                    ++num_given_up;
+                }
+                p->used = true;
+                p->resend = false;
+                p->retries = 0;
+                p->seq = seq;
+                p->sent_us = micros();
+                p->ip = ip;
+                p->port = port;
+                p->data.assign((const char*)data, (const char*)data + size);
+                ++num_sent;
+            }
+
+            // returns false if the packet is not pending (already acknowledged or given up)
+            bool ack(const IPAddress& ip, const uint16_t port, const uint32_t seq) {
+                Pending* p = find(ip, port, seq);
+                if (!p) return false;
+                p->used = false;
+                ++num_acked;
+                return true;
+            }
+
+            // mark the lost packets to be resent in the next retransmitDue(), returns the number of them
+            size_t nack(const IPAddress& ip, const uint16_t port, const uint32_t first, const uint32_t count) {
+                size_t n = 0;
+                for (uint32_t i = 0; i < count; ++i) {
+                    Pending* p = find(ip, port, first + i);
+                    if (!p) continue;
+                    p->resend = true;
+                    ++n;
+                }
+                return n;
+            }
+
+            // calls f(ip, port, data, size) -> bool for every packet whose timeout is over or which is reported as lost
+            // the packet is given up after max_retries
+            template <typename F>
+            size_t retransmitDue(F&& f) {
+                size_t n = 0;
+                const uint32_t now = micros();
+                for (auto& s : slots) {
+                    if (!s.used) continue;
+                    const uint32_t wait_us = timeout_us << (s.retries < 16 ? s.retries : 16);
+                    if (!s.resend && ((uint32_t)(now - s.sent_us) < wait_us)) continue;
+                    if (s.retries >= max_retries) {
+                        LOG_ERROR(F("reliable message was not acknowledged, gave up seq"), s.seq);
+                        s.used = false;
+                        ++num_given_up;
+                        continue;
+                    }
+                    s.resend = false;
+                    ++s.retries;
+                    s.sent_us = now;
+                    f(s.ip, s.port, (const uint8_t*)s.data.data(), s.data.size());
+                    ++num_retransmitted;
+                    ++n;
+                }
+                return n;
+            }
+
+            // packets which are not acknowledged yet
+            size_t pending() const {
+                size_t n = 0;
+                for (const auto& s : slots)
+                    if (s.used) ++n;
+                return n;
+            }
+
+            uint32_t sent() const { return num_sent; }
+            uint32_t acked() const { return num_acked; }
+            uint32_t retransmitted() const { return num_retransmitted; }
+            uint32_t givenUp() const { return num_given_up; }
+
+        private:
+            // the oldest destination without pending packets is forgotten if the table is full
+            // the new entry starts the new session, so its sequence can start from 1 again
+            Peer* findPeer(const IPAddress& ip, const uint16_t port) {
+                for (size_t i = 0; i < num_peers; ++i)
+                    if ((peers[i].ip == ip) && (peers[i].port == port)) return &peers[i];
+                if (num_peers >= ARDUINOOSC_RELIABLE_MAX_PEERS) {
+                    size_t idx = 0;
+                    while ((idx < num_peers) && isPending(peers[idx].ip, peers[idx].port)) ++idx;
+                    if (idx >= num_peers) {
+                        LOG_ERROR(F("all reliable destinations have pending packets, max is"), ARDUINOOSC_RELIABLE_MAX_PEERS);
+                        return nullptr;
+                    }
+                    for (size_t i = idx + 1; i < num_peers; ++i) peers[i - 1] = peers[i];
+                    --num_peers;
+                }
+                Peer& p = peers[num_peers++];
+                p.ip = ip;
+                p.port = port;
+                p.session = next_session;
+                p.next_seq = 1;
+                next_session += 2;  // odd, never 0
+                return &p;
+            }
+
+            bool isPending(const IPAddress& ip, const uint16_t port) const {
+                for (const auto& s : slots)
+                    if (s.used && (s.port == port) && (s.ip == ip)) return true;
+                return false;
+            }
+
+            Pending* find(const IPAddress& ip, const uint16_t port, const uint32_t seq) {
+                for (auto& s : slots)
+                    if (s.used && (s.seq == seq) && (s.port == port) && (s.ip == ip)) return &s;
+                return nullptr;
+            }
+        };
+
+        // accepts each envelope only once per sender, and replies ACK (and NACK for the gap of the sequence)
+        // senders are identified by the remote ip and the ack port in the envelope, and counted for each local port
+        // because the sender has the sequence for each destination
+        class Receiver {
+        public:
+            using ReplyCallback = std::function<void(const IPAddress&, const uint16_t, Message&)>;
+
+        private:
+            struct Peer {
+                IPAddress ip;
+                uint16_t port {0};
+                uint16_t local_port {0};
+                uint32_t session {0};
+                uint32_t highest {0};  // highest sequence number received
+                uint32_t mask {0};     // bit i: highest - i is received
+                uint32_t last_us {0};
+            };
+
+            Peer peers[ARDUINOOSC_RELIABLE_MAX_PEERS];
+            size_t num_peers {0};
+            ReplyCallback reply;
+            Message reply_msg;
+
+            uint32_t num_accepted {0};
+            uint32_t num_duplicated {0};
+            uint32_t num_nacked {0};
+            uint32_t num_rejected {0};
+
+        public:
+            static constexpr uint32_t WINDOW {32};
+
+            void onReply(const ReplyCallback& cb) { reply = cb; }
+
+            // M is Message or MessageView, returns true and the encoded message if it is received first time
+            template <typename M>
+            bool accept(const M& env, const IPAddress& ip, const uint16_t local_port, const uint8_t*& data, size_t& size) {
+                if ((env.size() != ENVELOPE_NUM_ARGS) || (memcmp(schema::type_tags_of(env), ENVELOPE_TYPE_TAGS, ENVELOPE_NUM_ARGS) != 0)) {
+                    LOG_ERROR(F("reliable envelope type tags mismatch:"), schema::type_tags_of(env));
+                    ++num_rejected;
+                    return false;
+                }
+                const uint32_t session = (uint32_t)env.getArgAsInt32(0);
+                const uint32_t seq = (uint32_t)env.getArgAsInt32(1);
+                const uint16_t ack_port = (uint16_t)env.getArgAsInt32(2);
+                data = env.getArgAsBlobPtr(3, size);
+
+                Peer& peer = find(ip, ack_port, local_port);
+                if (peer.session != session) {
+                    peer.session = session;
+                    peer.highest = peer.mask = 0;
+                }
+                peer.last_us = micros();
+
+                uint32_t missing_first = 0, missing_count = 0;
+                const bool is_new = mark(peer, seq, missing_first, missing_count);
+
+                // duplicates are acknowledged again because the previous ACK may be lost
+                reply_msg.init(ACK_ADDRESS).pushInt32((int32_t)seq).pushInt32((int32_t)local_port);
+                if (reply) reply(ip, ack_port, reply_msg);
+                if (missing_count) {
+                    reply_msg.init(NACK_ADDRESS).pushInt32((int32_t)missing_first).pushInt32((int32_t)missing_count).pushInt32((int32_t)local_port);
+                    if (reply) reply(ip, ack_port, reply_msg);
+                    ++num_nacked;
+                }
+
+                if (is_new)
+                    ++num_accepted;
+                else
+                    ++num_duplicated;
+                return is_new;
+            }
+
+            uint32_t accepted() const { return num_accepted; }
+            uint32_t duplicated() const { return num_duplicated; }
+            uint32_t nacked() const { return num_nacked; }
+            uint32_t rejected() const { return num_rejected; }
+
+        private:
+            // the least recently heard sender is replaced if the table is full
+            Peer& find(const IPAddress& ip, const uint16_t port, const uint16_t local_port) {
+                for (size_t i = 0; i < num_peers; ++i)
+                    if ((peers[i].ip == ip) && (peers[i].port == port) && (peers[i].local_port == local_port)) return peers[i];
+                size_t idx = num_peers;
+                if (num_peers < ARDUINOOSC_RELIABLE_MAX_PEERS) {
+                    ++num_peers;
+                } else {
+                    idx = 0;
+                    for (size_t i = 1; i < num_peers; ++i)
+                        if ((int32_t)(peers[i].last_us - peers[idx].last_us) < 0) idx = i;
+                }
+                peers[idx] = Peer();
+                peers[idx].ip = ip;
+                peers[idx].port = port;
+                peers[idx].local_port = local_port;
+                return peers[idx];
+            }
+
+            // returns true if seq is not received yet, and the gap before it if it jumps ahead
+            static bool mark(Peer& p, const uint32_t seq, uint32_t& missing_first, uint32_t& missing_count) {
+                if (p.mask == 0) {
+                    p.highest = seq;
+                    p.mask = 1;
+                    return true;
+                }
+                const int32_t d = (int32_t)(seq - p.highest);
+                if (d > 0) {
+                    if (d > 1) {
+                        missing_first = p.highest + 1;
+                        missing_count = ((uint32_t)d - 1 < WINDOW) ? (uint32_t)d - 1 : WINDOW;
+                    }
+                    p.mask = ((uint32_t)d < WINDOW) ? (p.mask << d) : 0;
+                    p.mask |= 1;
+                    p.highest = seq;
+                    return true;
+                }
+                const uint32_t back = (uint32_t)(-d);
+                if (back >= WINDOW) return false;  // too old, regarded as received
+                const uint32_t bit = (uint32_t)1 << back;
+                if (p.mask & bit) return false;
+                p.mask |= bit;
+                return true;
+            }
+        };
+
+    }  // namespace reliable
+}  // namespace osc
+}  // namespace arduino
+
+using OscReliableSender = arduino::osc::reliable::Sender;
+using OscReliableReceiver = arduino::osc::reliable::Receiver;
+
+#endif  // ARDUINOOSC_OSCRELIABLE_H
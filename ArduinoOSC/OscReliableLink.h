@@ -0,0 +1,82 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCRELIABLELINK_H
+#define ARDUINOOSC_OSCRELIABLELINK_H
+
+#include <Arduino.h>
+#include <DebugLog.h>
+#include "OscReliable.h"
+#include "OSCServer.h"
+#include "OSCClient.h"
+
+namespace arduino {
+namespace osc {
+
+    // connects reliable::Sender to the client and reliable::Receiver to the servers
+    //   sending node   : begin(ack_port) and add(addr), then send() the messages to the address as usual
+    //   receiving node : serve(port), the envelopes received on the port are unwrapped before dispatched
+    // both roles can be used in the same node
+    template <typename S>
+    class ReliableLink {
+        ReliableLink() {}
+        ReliableLink(const ReliableLink&) = delete;
+        ReliableLink& operator=(const ReliableLink&) = delete;
+
+        reliable::Sender sender;
+        reliable::Receiver receiver;
+        uint16_t ack_port {0};  // ACK / NACK are subscribed on it
+
+    public:
+        static ReliableLink<S>& getInstance() {
+            static ReliableLink<S> l;
+            return l;
+        }
+
+        // ACK / NACK from the receivers are received on the port
+        // calling it again (e.g. after end()) does not subscribe them twice
+        void begin(const uint16_t port) {
+            sender.begin(port);
+            client::Manager<S>::getInstance().getClient().useReliable(&sender);
+            if (ack_port == port) return;
+            ack_port = port;
+
+            server::Server<S>& server = server::Manager<S>::getInstance().getServer(port);
+            server.subscribe(reliable::ACK_ADDRESS, [](const message::Message& m) {
+                if (m.size() < 2) return;
+                ReliableLink<S>::getInstance().sender.ack(m.remoteAddress(), (uint16_t)m.getArgAsInt32(1), (uint32_t)m.getArgAsInt32(0));
+            });
+            server.subscribe(reliable::NACK_ADDRESS, [](const message::Message& m) {
+                if (m.size() < 3) return;
+                ReliableLink<S>::getInstance().sender.nack(m.remoteAddress(), (uint16_t)m.getArgAsInt32(2), (uint32_t)m.getArgAsInt32(0), (uint32_t)m.getArgAsInt32(1));
+            });
+        }
+
+        // messages to the addresses are sent as best effort again, unacknowledged ones are not resent
+        void end() {
+            client::Manager<S>::getInstance().getClient().useReliable(nullptr);
+        }
+
+        bool add(const String& addr) { return sender.add(addr); }
+        bool remove(const String& addr) { return sender.remove(addr); }
+
+        // receive the envelopes on the port, ACK / NACK are sent back to the ack port of the sender
+        void serve(const uint16_t port) {
+            receiver.onReply([](const IPAddress& ip, const uint16_t port, message::Message& m) {
+                client::Manager<S>::getInstance().getClient().sendTo(ip, port, m);
+            });
+            server::Manager<S>::getInstance().getServer(port).useReliable(&receiver);
+        }
+
+        reliable::Sender& getSender() { return sender; }
+        const reliable::Sender& getSender() const { return sender; }
+        reliable::Receiver& getReceiver() { return receiver; }
+        const reliable::Receiver& getReceiver() const { return receiver; }
+    };
+
+}  // namespace osc
+}  // namespace arduino
+
+template <typename S>
+using OscReliableLink = arduino::osc::ReliableLink<S>;
+
+#endif  // ARDUINOOSC_OSCRELIABLELINK_H
@@ -0,0 +1,126 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCRING_H
+#define ARDUINOOSC_OSCRING_H
+
+#include <Arduino.h>
+#include <ArxTypeTraits.h>
+
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+
+#include <atomic>
+
+namespace arduino {
+namespace osc {
+
+    // lock-free ring for one producer and one consumer (e.g. network task and loop task)
+    // the producer fills the slot from reserve() and publishes it by commit(),
+    // the consumer reads the slot from front() and gives it back by pop()
+    template <typename T, size_t N>
+    class SpscRing {
+        static_assert((N != 0) && ((N & (N - 1)) == 0), "size of SpscRing must be power of 2");
+
+        T slots[N];
+        std::atomic<size_t> head {0};  // written only by the producer
+        std::atomic<size_t> tail {0};  // written only by the consumer
+
+    public:
+        // producer: returns nullptr if the ring is full
+        T* reserve() {
+            const size_t h = head.load(std::memory_order_relaxed);
+            if (h - tail.load(std::memory_order_acquire) >= N) return nullptr;
+            return &slots[h & (N - 1)];
+        }
+        void commit() {
+            head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        // consumer: returns nullptr if the ring is empty
+        T* front() {
+            const size_t t = tail.load(std::memory_order_relaxed);
+            if (t == head.load(std::memory_order_acquire)) return nullptr;
+            return &slots[t & (N - 1)];
+        }
+        void pop() {
+            tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        size_t size() const {
+            return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+        }
+        bool empty() const { return size() == 0; }
+        static constexpr size_t capacity() { return N; }
+    };
+
+    // bounded lock-free queue for many producers and one consumer
+    // each cell has the sequence number which tells whether it is free or committed,
+    // and the consumer takes the cells strictly in the order of reserve(),
+    // so the items from one producer are kept in order
+    template <typename T, size_t N>
+    class MpscQueue {
+        static_assert((N != 0) && ((N & (N - 1)) == 0), "size of MpscQueue must be power of 2");
+
+        struct Cell {
+            std::atomic<size_t> seq;
+            T value;
+        };
+
+        Cell cells[N];
+        std::atomic<size_t> enqueue_pos {0};
+        std::atomic<size_t> dequeue_pos {0};  // written only by the consumer
+
+    public:
+        MpscQueue() {
+            for (size_t i = 0; i < N; ++i) cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+
+        // producer: returns nullptr if the queue is full, pass the ticket to commit()
+        T* reserve(size_t& ticket) {
+            size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+            while (true) {
+                Cell& c = cells[pos & (N - 1)];
+                const size_t seq = c.seq.load(std::memory_order_acquire);
+                const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+                if (diff == 0) {
+                    if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        ticket = pos;
+                        return &c.value;
+                    }
+                } else if (diff < 0) {
+                    return nullptr;
+                } else {
+                    pos = enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+        void commit(const size_t ticket) {
+            cells[ticket & (N - 1)].seq.store(ticket + 1, std::memory_order_release);
+        }
+
+        // consumer: returns nullptr if the next cell is not committed yet
+        T* front() {
+            const size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+            Cell& c = cells[pos & (N - 1)];
+            if (c.seq.load(std::memory_order_acquire) != pos + 1) return nullptr;
+            return &c.value;
+        }
+        void pop() {
+            const size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+            cells[pos & (N - 1)].seq.store(pos + N, std::memory_order_release);
+            dequeue_pos.store(pos + 1, std::memory_order_relaxed);
+        }
+
+        // approximate while the producers are running
+        size_t size() const {
+            return enqueue_pos.load(std::memory_order_relaxed) - dequeue_pos.load(std::memory_order_relaxed);
+        }
+        bool empty() const { return size() == 0; }
+        static constexpr size_t capacity() { return N; }
+    };
+
+}  // namespace osc
+}  // namespace arduino
+
+#endif  // Have libstdc++11
+
+#endif  // ARDUINOOSC_OSCRING_H
@@ -0,0 +1,42 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCRXBUFFER_H
+#define ARDUINOOSC_OSCRXBUFFER_H
+
+#include <Arduino.h>
+#include "OscTypes.h"
+
+namespace arduino {
+namespace osc {
+
+    // receive buffer shared by all the servers, so the memory does not grow with the number of ports
+    // servers are parsed one by one in the loop, and the packet is read into the buffer only while it is parsed
+    // it is overwritten by the next packet of any server, so the messages and views are valid only in the callbacks
+    // (subscriptions which outlive the packet, e.g. workers and coalescing, copy the message)
+    // packets larger than ARDUINOOSC_RX_BUFFER_SIZE are dropped and counted by Server::dropped()
+    // transports which keep the whole packet (S::packetData(), e.g. SLIP and AsyncUDP) are parsed in place,
+    // so the buffer is not used (and not allocated if no other transport is used)
+    struct RxBuffer {
+        uint8_t data[ARDUINOOSC_RX_BUFFER_SIZE];
+        size_t size {0};
+
+        static constexpr size_t capacity() { return ARDUINOOSC_RX_BUFFER_SIZE; }
+
+        static RxBuffer& shared() {
+            static RxBuffer b;
+            return b;
+        }
+
+        // a packet is being parsed by any server (parse() was called again from the callback)
+        static bool& busy() {
+            static bool b {false};
+            return b;
+        }
+    };
+
+}  // namespace osc
+}  // namespace arduino
+
+using OscRxBuffer = arduino::osc::RxBuffer;
+
+#endif  // ARDUINOOSC_OSCRXBUFFER_H
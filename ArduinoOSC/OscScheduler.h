@@ -0,0 +1,151 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCSCHEDULER_H
+#define ARDUINOOSC_OSCSCHEDULER_H
+
+#include <Arduino.h>
+#include <DebugLog.h>
+#include "OscTypes.h"
+#include "OscMessage.h"
+#include "OscClock.h"
+
+namespace arduino {
+namespace osc {
+    namespace server {
+
+        using namespace message;
+
+        struct ScheduledMessage {
+            Message msg;
+            bool used {false};
+        };
+
+        struct ScheduleEntry {
+            uint64_t time_tag;
+            uint32_t seq;  // keeps the arrival order of the messages which have same time tag
+            uint16_t slot;
+        };
+
+        // holds the messages with future time tag in the min-heap and hands them out when they are due
+        // time tags are compared with Clock, so messages are not deferred until the Clock is set
+        class Scheduler {
+            ScheduledMessageList slots;  // messages are not moved after they are stored
+            ScheduleHeap heap;
+            uint32_t seq {0};
+
+        public:
+            // the slots are reserved so that the message being dispatched is not moved by push() in the callback
+            void reserve() {
+                slots.reserve(ARDUINOOSC_MAX_SCHEDULED_MSG_SIZE);
+                heap.reserve(ARDUINOOSC_MAX_SCHEDULED_MSG_SIZE);
+            }
+
+            // true if the message with this time tag should be deferred
+            bool isDeferred(const TimeTag& tt) const {
+                Clock& clock = Clock::getInstance();
+                if (!clock.isSet() || (tt.value() == TimeTag::immediate().value())) return false;
+                return tt.value() > clock.now().value();
+            }
+
+            // returns false if the queue is full
+            bool push(const Message& m) {
+                if (heap.size() >= ARDUINOOSC_MAX_SCHEDULED_MSG_SIZE) {
+                    LOG_ERROR(F("scheduled message queue is full, max size is"), ARDUINOOSC_MAX_SCHEDULED_MSG_SIZE);
+                    return false;
+                }
+
+                size_t slot = 0;
+                while ((slot < slots.size()) && slots[slot].used) ++slot;
+                if (slot == slots.size()) slots.push_back(ScheduledMessage());
+                slots[slot].msg = m;
+                slots[slot].used = true;
+
+                ScheduleEntry e;
+                e.time_tag = m.timeTag().value();
+                e.seq = seq++;
+                e.slot = (uint16_t)slot;
+                heap.push_back(e);
+                siftUp(heap.size() - 1);
+                return true;
+            }
+
+            // calls f(Message&) for every message which is due, in time tag order
+            template <typename F>
+            size_t dispatchDue(F&& f) {
+                if (heap.empty()) return 0;
+                Clock& clock = Clock::getInstance();
+                return dispatchUntil(clock.isSet() ? clock.now().value() : ~(uint64_t)0, f);
+            }
+
+            // calls f(Message&) for every message even if it is not due, in time tag order
+            template <typename F>
+            size_t dispatchAll(F&& f) {
+                return dispatchUntil(~(uint64_t)0, f);
+            }
+
+            // time tag of the next message, or immediate if no message is scheduled
+            TimeTag next() const {
+                return heap.empty() ? TimeTag::immediate() : TimeTag(heap.front().time_tag);
+            }
+
+            size_t size() const { return heap.size(); }
+            bool empty() const { return heap.empty(); }
+
+            void clear() {
+                heap.clear();
+                for (auto& s : slots) s.used = false;
+            }
+
+        private:
+            template <typename F>
+            size_t dispatchUntil(const uint64_t now, F& f) {
+                size_t n = 0;
+                while (!heap.empty() && (heap.front().time_tag <= now)) {
+                    const uint16_t slot = heap.front().slot;
+                    heap.front() = heap.back();
+                    heap.pop_back();
+                    if (!heap.empty()) siftDown(0);
+                    f(slots[slot].msg);
+                    slots[slot].used = false;
+                    ++n;
+                }
+                return n;
+            }
+
+            static bool earlier(const ScheduleEntry& a, const ScheduleEntry& b) {
+                return (a.time_tag != b.time_tag) ? (a.time_tag < b.time_tag) : ((int32_t)(a.seq - b.seq) < 0);
+            }
+
+            void siftUp(size_t i) {
+                while (i > 0) {
+                    const size_t parent = (i - 1) / 2;
+                    if (!earlier(heap[i], heap[parent])) break;
+                    const ScheduleEntry tmp = heap[i];
+                    heap[i] = heap[parent];
+                    heap[parent] = tmp;
+                    i = parent;
+                }
+            }
+
+            void siftDown(size_t i) {
+                const size_t sz = heap.size();
+                while (true) {
+                    const size_t l = 2 * i + 1;
+                    const size_t r = l + 1;
+                    size_t m = i;
+                    if ((l < sz) && earlier(heap[l], heap[m])) m = l;
+                    if ((r < sz) && earlier(heap[r], heap[m])) m = r;
+                    if (m == i) break;
+                    const ScheduleEntry tmp = heap[i];
+                    heap[i] = heap[m];
+                    heap[m] = tmp;
+                    i = m;
+                }
+            }
+        };
+
+    }  // namespace server
+}  // namespace osc
+}  // namespace arduino
+
+#endif  // ARDUINOOSC_OSCSCHEDULER_H
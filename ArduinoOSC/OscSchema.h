@@ -0,0 +1,160 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCSCHEMA_H
+#define ARDUINOOSC_OSCSCHEMA_H
+
+#include <Arduino.h>
+#include <ArxTypeTraits.h>
+#include <DebugLog.h>
+#include "OscTypes.h"
+#include "OscUtil.h"
+#include "OscMessage.h"
+#include "OscMessageView.h"
+
+namespace arduino {
+namespace osc {
+    namespace message {
+
+        namespace schema {
+
+            // only fixed size arguments can be used in the schema
+            template <typename T, typename = void>
+            struct arg_traits;
+
+            template <typename T>
+            struct arg_traits<T, std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value && (sizeof(T) <= 4)>> {
+                using wire_type = int32_t;
+                static constexpr char tag = TYPE_TAG_INT32;
+            };
+            template <typename T>
+            struct arg_traits<T, std::enable_if_t<std::is_integral<T>::value && (sizeof(T) == 8)>> {
+                using wire_type = int64_t;
+                static constexpr char tag = TYPE_TAG_INT64;
+            };
+            template <>
+            struct arg_traits<float> {
+                using wire_type = float;
+                static constexpr char tag = TYPE_TAG_FLOAT;
+            };
+            template <>
+            struct arg_traits<double> {
+                using wire_type = double;
+                static constexpr char tag = TYPE_TAG_DOUBLE;
+            };
+
+            template <typename T>
+            using wire_t = typename arg_traits<std::remove_cvref_t<T>>::wire_type;
+
+            // byte offset of the I-th argument
+            template <size_t I, typename... Ts>
+            struct offset_of;
+            template <typename T, typename... Ts>
+            struct offset_of<0, T, Ts...> {
+                static constexpr size_t value = 0;
+            };
+            template <size_t I, typename T, typename... Ts>
+            struct offset_of<I, T, Ts...> {
+                static constexpr size_t value = sizeof(wire_t<T>) + offset_of<I - 1, Ts...>::value;
+            };
+
+            template <typename... Ts>
+            struct size_of {
+                static constexpr size_t value = 0;
+            };
+            template <typename T, typename... Ts>
+            struct size_of<T, Ts...> {
+                static constexpr size_t value = sizeof(wire_t<T>) + size_of<Ts...>::value;
+            };
+
+            inline const char* type_tags_of(const Message& m) { return m.typeTags().c_str(); }
+            inline const char* type_tags_of(const MessageView& m) { return m.typeTags(); }
+
+        }  // namespace schema
+
+        // message with a fixed address and the fixed argument types
+        // type tags and argument offsets are resolved at compile time, and the padded header is encoded once,
+        // so encoding writes only the arguments into the packet buffer and decoding checks type tags at once
+        template <typename... Ts>
+        class Schema {
+        public:
+            static constexpr size_t NUM_ARGS = sizeof...(Ts);
+            static constexpr size_t TYPE_TAGS_SIZE = (NUM_ARGS + 2 + 3) & ~(size_t)3;  // ',' + tags + '\0' with padding
+            static constexpr size_t ARGS_SIZE = schema::size_of<Ts...>::value;
+            static constexpr char type_tags[NUM_ARGS + 2] = {',', schema::arg_traits<std::remove_cvref_t<Ts>>::tag..., '\0'};
+
+        private:
+            String address_str;
+            Blob packet;  // header and arguments
+            size_t header_size {0};
+
+        public:
+            explicit Schema(const String& addr)
+            : address_str(addr) {
+                const size_t addr_size = ceil4(addr.length() + 1);
+                header_size = addr_size + TYPE_TAGS_SIZE;
+                packet.resize(header_size + ARGS_SIZE);  // filled with zeros, so the zero padding is OK
+                memcpy(&packet[0], addr.c_str(), addr.length());
+                memcpy(&packet[addr_size], type_tags, NUM_ARGS + 1);
+            }
+
+            const String& address() const { return address_str; }
+            // without the initial ','
+            static const char* typeTags() { return type_tags + 1; }
+
+            // encode the arguments into the packet buffer, the returned data is valid until next encode()
+            template <typename... Args>
+            const uint8_t* encode(const Args&... args) {
+                static_assert(sizeof...(Args) == NUM_ARGS, "number of arguments must be same as the schema");
+                encode_impl(std::index_sequence_for<Ts...>(), args...);
+                return data();
+            }
+
+            const uint8_t* data() const { return (const uint8_t*)packet.data(); }
+            size_t size() const { return packet.size(); }
+
+            // true if the message has exactly the same type tags
+            template <typename M>
+            static bool match(const M& m) {
+                return (m.size() == NUM_ARGS) && (memcmp(schema::type_tags_of(m), typeTags(), NUM_ARGS) == 0);
+            }
+
+            // read the arguments from the message, returns false if the type tags are not matched
+            template <typename M>
+            static bool decode(const M& m, std::tuple<std::remove_cvref_t<Ts>...>& t) {
+                if (!match(m)) return false;
+                decode_impl(std::index_sequence_for<Ts...>(), m.argumentsData(), t);
+                return true;
+            }
+
+        private:
+            template <size_t... Is, typename... Args>
+            void encode_impl(std::index_sequence<Is...>&&, const Args&... args) {
+                char* p = &packet[header_size];
+                using swallow = int[];
+                (void)swallow {0, (pod2bytes<schema::wire_t<Ts>>((schema::wire_t<Ts>)args, p + schema::offset_of<Is, Ts...>::value), 0)...};
+            }
+
+            template <size_t... Is>
+            static void decode_impl(std::index_sequence<Is...>&&, const char* p, std::tuple<std::remove_cvref_t<Ts>...>& t) {
+                using swallow = int[];
+                (void)swallow {0, (std::get<Is>(t) = (std::remove_cvref_t<Ts>)bytes2pod<schema::wire_t<Ts>>(p + schema::offset_of<Is, Ts...>::value), 0)...};
+            }
+        };
+
+        template <typename... Ts>
+        constexpr size_t Schema<Ts...>::NUM_ARGS;
+        template <typename... Ts>
+        constexpr size_t Schema<Ts...>::TYPE_TAGS_SIZE;
+        template <typename... Ts>
+        constexpr size_t Schema<Ts...>::ARGS_SIZE;
+        template <typename... Ts>
+        constexpr char Schema<Ts...>::type_tags[];
+
+    }  // namespace message
+}  // namespace osc
+}  // namespace arduino
+
+template <typename... Ts>
+using OscSchema = arduino::osc::message::Schema<Ts...>;
+
+#endif  // ARDUINOOSC_OSCSCHEMA_H
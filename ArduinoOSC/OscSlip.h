@@ -0,0 +1,270 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCSLIP_H
+#define ARDUINOOSC_OSCSLIP_H
+
+#include <Arduino.h>
+#include <ArxTypeTraits.h>
+#include <DebugLog.h>
+#include "OscTypes.h"
+#include "OscUdpMap.h"
+
+#ifndef ARDUINOOSC_SLIP_TX_BATCH_SIZE
+#define ARDUINOOSC_SLIP_TX_BATCH_SIZE 64  // escaped bytes written to the stream at once
+#endif
+
+namespace arduino {
+namespace osc {
+    namespace slip {
+
+        // RFC 1055
+        static constexpr uint8_t FRAME_END {0xC0};
+        static constexpr uint8_t FRAME_ESC {0xDB};
+        static constexpr uint8_t TRANSPOSED_FRAME_END {0xDC};
+        static constexpr uint8_t TRANSPOSED_FRAME_ESC {0xDD};
+
+        // unescapes the stream byte by byte into the buffer, so the frame can be split into any pieces
+        // and nothing but the decoded packet is buffered
+        class Decoder {
+            enum class State : uint8_t { DATA, ESCAPE, DISCARD };
+
+            uint8_t* buf {nullptr};
+            size_t cap {0};
+            size_t len {0};
+            State state {State::DATA};
+
+        public:
+            enum class Result : uint8_t { PENDING, COMPLETE, BROKEN };
+
+            Decoder(uint8_t* buffer, const size_t capacity)
+            : buf(buffer), cap(capacity) {}
+
+            // COMPLETE: the decoded packet is in data() / size() until clear()
+            // BROKEN: the frame is broken (bad escape or too large) and is discarded until the next FRAME_END
+            Result feed(const uint8_t c) {
+                if (c == FRAME_END) {
+                    // ESC + END is a protocol violation, the partial frame is discarded and counted
+                    if (state == State::ESCAPE) {
+                        len = 0;
+                        state = State::DATA;
+                        return Result::BROKEN;
+                    }
+                    const bool is_frame = (state == State::DATA) && (len != 0);  // empty frames are ignored
+                    state = State::DATA;
+                    if (!is_frame) len = 0;
+                    return is_frame ? Result::COMPLETE : Result::PENDING;
+                }
+                switch (state) {
+                    case State::DISCARD:
+                        return Result::PENDING;
+                    case State::ESCAPE:
+                        if (c == TRANSPOSED_FRAME_END)
+                            return push(FRAME_END);
+                        else if (c == TRANSPOSED_FRAME_ESC)
+                            return push(FRAME_ESC);
+                        return discard();
+                    case State::DATA:
+                    default:
+                        if (c == FRAME_ESC) {
+                            state = State::ESCAPE;
+                            return Result::PENDING;
+                        }
+                        return push(c);
+                }
+            }
+
+            const uint8_t* data() const { return buf; }
+            size_t size() const { return len; }
+            void clear() {
+                len = 0;
+                state = State::DATA;
+            }
+
+        private:
+            Result push(const uint8_t c) {
+                if (len >= cap) return discard();
+                buf[len++] = c;
+                state = State::DATA;
+                return Result::PENDING;
+            }
+            Result discard() {
+                len = 0;
+                state = State::DISCARD;
+                return Result::BROKEN;
+            }
+        };
+
+        // escapes the packet into the small batch and writes it to the stream when it is full
+        // frames start and end with FRAME_END (double-ended, as recommended by OSC 1.1)
+        class Encoder {
+            uint8_t batch[ARDUINOOSC_SLIP_TX_BATCH_SIZE];
+            size_t len {0};
+            bool is_failed {false};
+
+        public:
+            template <typename T>
+            void begin(T& stream) {
+                len = 0;
+                is_failed = false;
+                put(stream, FRAME_END);
+            }
+
+            template <typename T>
+            void write(T& stream, const uint8_t* data, const size_t size) {
+                for (size_t i = 0; i < size; ++i) {
+                    const uint8_t c = data[i];
+                    if (c == FRAME_END) {
+                        put(stream, FRAME_ESC);
+                        put(stream, TRANSPOSED_FRAME_END);
+                    } else if (c == FRAME_ESC) {
+                        put(stream, FRAME_ESC);
+                        put(stream, TRANSPOSED_FRAME_ESC);
+                    } else {
+                        put(stream, c);
+                    }
+                }
+            }
+
+            // returns false if any byte could not be written since begin()
+            template <typename T>
+            bool end(T& stream) {
+                put(stream, FRAME_END);
+                flush(stream);
+                return !is_failed;
+            }
+
+        private:
+            template <typename T>
+            void put(T& stream, const uint8_t c) {
+                if (len == sizeof(batch)) flush(stream);
+                batch[len++] = c;
+            }
+
+            template <typename T>
+            void flush(T& stream) {
+                if (len && (stream.write(batch, len) != len)) is_failed = true;
+                len = 0;
+            }
+        };
+
+    }  // namespace slip
+
+    // SLIP framed transport on the serial or tcp stream, to be used as S of Manager / Server / Client
+    // it has the interface of WiFiUDP, and the "port" is only the key of UdpMapManager to pick the stream
+    // the destination of send() is ignored and the frame is written to the stream of the local port of the client
+    // the remote ip of the received message is always 0.0.0.0 and the remote port is the local port
+    // T is the stream (Stream, HardwareSerial, WiFiClient, ...) which has available(), read() and write(buf, size)
+    template <typename T>
+    class SlipTransport {
+        T* stream {nullptr};
+        uint16_t local_port {0};
+
+        uint8_t rx_buf[ARDUINOOSC_RX_BUFFER_SIZE];  // the frame is decoded and parsed here
+        slip::Decoder decoder {rx_buf, sizeof(rx_buf)};
+        size_t rx_size {0};
+        size_t rx_pos {0};
+        uint32_t num_dropped {0};
+
+        slip::Encoder encoder;
+        bool is_tx_began {false};
+
+    public:
+        SlipTransport() {}
+        SlipTransport(const SlipTransport&) = delete;
+        SlipTransport& operator=(const SlipTransport&) = delete;
+
+        // set the stream of the port, call before the first parse() / send() of it
+        static void attach(const uint16_t port, T& s) {
+            UdpMapManager<SlipTransport>::getInstance().getUdp(port)->attach(s);
+        }
+        void attach(T& s) { stream = &s; }
+        T* getStream() const { return stream; }
+
+        uint8_t begin(const uint16_t port) {
+            local_port = port;
+            return 1;
+        }
+        uint8_t beginMulticast(const IPAddress&, const IPAddress&, const uint16_t port) {
+            return begin(port);
+        }
+        void stop() {}
+        uint16_t localPort() const { return local_port; }
+
+        // frames which were broken or larger than ARDUINOOSC_RX_BUFFER_SIZE
+        uint32_t dropped() const { return num_dropped; }
+
+        // receiver interface of WiFiUDP
+        // reads only the bytes available now, and a partial frame is continued in the next call
+
+        int parsePacket() {
+            if (rx_size) {
+                decoder.clear();
+                rx_size = rx_pos = 0;
+            }
+            if (!stream) return 0;
+            while (stream->available() > 0) {
+                const int c = stream->read();
+                if (c < 0) break;
+                const slip::Decoder::Result r = decoder.feed((uint8_t)c);
+                if (r == slip::Decoder::Result::COMPLETE) {
+                    rx_size = decoder.size();
+                    return (int)rx_size;
+                } else if (r == slip::Decoder::Result::BROKEN) {
+                    ++num_dropped;
+                    LOG_ERROR(F("slip frame is broken or too large, must be <="), sizeof(rx_buf));
+                }
+            }
+            return 0;
+        }
+
+        int available() { return (int)(rx_size - rx_pos); }
+
+        int read(uint8_t* buffer, const size_t len) {
+            const size_t n = (size_t)available() < len ? (size_t)available() : len;
+            if (n) memcpy(buffer, rx_buf + rx_pos, n);
+            rx_pos += n;
+            return (int)n;
+        }
+        int read(char* buffer, const size_t len) { return read((uint8_t*)buffer, len); }
+
+        // the completed frame is parsed in place by the server, so it is not copied again
+        const uint8_t* packetData() const { return rx_buf; }
+
+        IPAddress remoteIP() { return IPAddress(); }
+        uint16_t remotePort() { return local_port; }
+
+        // sender interface of WiFiUDP, the destination is ignored and the frame is written to the stream
+
+        int beginPacket(const IPAddress&, const uint16_t) { return beginFrame(); }
+        int beginPacket(const char*, const uint16_t) { return beginFrame(); }
+        int beginPacketMulticast(const IPAddress&, const uint16_t, const IPAddress&, const int = 1) { return beginFrame(); }
+
+        size_t write(const uint8_t* buffer, const size_t size) {
+            if (!is_tx_began) return 0;
+            encoder.write(*stream, buffer, size);
+            return size;
+        }
+        size_t write(const uint8_t c) { return write(&c, 1); }
+
+        int endPacket() {
+            if (!is_tx_began) return 0;
+            is_tx_began = false;
+            return encoder.end(*stream) ? 1 : 0;
+        }
+
+    private:
+        int beginFrame() {
+            if (!stream) return 0;
+            encoder.begin(*stream);
+            is_tx_began = true;
+            return 1;
+        }
+    };
+
+}  // namespace osc
+}  // namespace arduino
+
+template <typename T>
+using OscSlipTransport = arduino::osc::SlipTransport<T>;
+
+#endif  // ARDUINOOSC_OSCSLIP_H
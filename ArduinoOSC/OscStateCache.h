@@ -0,0 +1,88 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCSTATECACHE_H
+#define ARDUINOOSC_OSCSTATECACHE_H
+
+#include <Arduino.h>
+#include <DebugLog.h>
+#include "OscTypes.h"
+#include "OscUtil.h"
+
+namespace arduino {
+namespace osc {
+    namespace client {
+
+        struct StateEntry {
+            uint32_t hash {0};
+            String address;
+            Blob data;  // encoded message as it was sent last
+        };
+
+        // latest encoded message of every address sent by the client
+        // the bytes encoded for sending are copied as they are, so nothing is encoded again for the dump
+        class StateCache {
+            StateCacheList entries;
+            uint32_t num_dropped {0};
+
+        public:
+            static constexpr const char* DUMP_ADDRESS {"/state/dump"};
+
+            // requests of the clock sync and the dump are not the state, replaying them would confuse the peers
+            static bool isControl(const String& addr) {
+                return addr.startsWith("/state/") || addr.startsWith("/sync/");
+            }
+
+            void update(const String& addr, const uint8_t* data, const size_t size) {
+                if (isControl(addr)) return;
+                const uint32_t h = fnv1a(addr.c_str(), addr.length());
+                for (auto& e : entries) {
+                    if ((e.hash != h) || (e.address != addr)) continue;
+                    e.data.assign((const char*)data, (const char*)data + size);
+                    return;
+                }
+#if ARX_HAVE_LIBSTDCPLUSPLUS < 201103L  // Don't have libstdc++11
+                if (entries.size() >= ARDUINOOSC_MAX_STATE_ENTRIES) {
+                    ++num_dropped;
+                    return;
+                }
+#endif
+                StateEntry e;
+                e.hash = h;
+                e.address = addr;
+                e.data.assign((const char*)data, (const char*)data + size);
+                entries.push_back(e);
+            }
+
+            bool remove(const String& addr) {
+                for (size_t i = 0; i < entries.size(); ++i) {
+                    if (entries[i].address != addr) continue;
+                    for (size_t j = i + 1; j < entries.size(); ++j) entries[j - 1] = entries[j];
+                    entries.pop_back();
+                    return true;
+                }
+                return false;
+            }
+            void clear() { entries.clear(); }
+
+            const StateEntry* find(const String& addr) const {
+                const uint32_t h = fnv1a(addr.c_str(), addr.length());
+                for (const auto& e : entries)
+                    if ((e.hash == h) && (e.address == addr)) return &e;
+                return nullptr;
+            }
+
+            const StateCacheList& getEntries() const { return entries; }
+            size_t size() const { return entries.size(); }
+            bool empty() const { return entries.empty(); }
+            // addresses which were not cached because the cache is full
+            uint32_t dropped() const { return num_dropped; }
+        };
+
+    }  // namespace client
+}  // namespace osc
+}  // namespace arduino
+
+using OscStateCache = arduino::osc::client::StateCache;
+using OscStateEntry = arduino::osc::client::StateEntry;
+
+#endif  // ARDUINOOSC_OSCSTATECACHE_H
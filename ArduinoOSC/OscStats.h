@@ -0,0 +1,116 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCSTATS_H
+#define ARDUINOOSC_OSCSTATS_H
+
+#include <Arduino.h>
+#include <ArxTypeTraits.h>
+
+// statistics of the receive and send path are compiled out unless ARDUINOOSC_ENABLE_STATS is defined
+
+#ifndef ARDUINOOSC_STATS_HISTOGRAM_BUCKETS
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+#define ARDUINOOSC_STATS_HISTOGRAM_BUCKETS 16
+#else
+#define ARDUINOOSC_STATS_HISTOGRAM_BUCKETS 8  // to be published within ARDUINOOSC_MAX_MSG_ARGUMENT_SIZE
+#endif
+#endif
+
+namespace arduino {
+namespace osc {
+    namespace server {
+
+        // bucket 0 counts 0-1 us, bucket i counts [2^i, 2^(i+1)) us and the last one counts all the rest
+        struct LatencyHistogram {
+            static constexpr size_t NUM_BUCKETS {ARDUINOOSC_STATS_HISTOGRAM_BUCKETS};
+            uint32_t buckets[NUM_BUCKETS] {};
+
+            static size_t bucketOf(uint32_t us) {
+                size_t i = 0;
+                while ((us >>= 1) && (i + 1 < NUM_BUCKETS)) ++i;
+                return i;
+            }
+            // upper bound of the bucket in microseconds (0xFFFFFFFF for the last one)
+            static uint32_t upperBound(const size_t i) {
+                return (i + 1 < NUM_BUCKETS) ? ((2UL << i) - 1) : 0xFFFFFFFF;
+            }
+
+            void add(const uint32_t us) { ++buckets[bucketOf(us)]; }
+
+            uint32_t count() const {
+                uint32_t n = 0;
+                for (size_t i = 0; i < NUM_BUCKETS; ++i) n += buckets[i];
+                return n;
+            }
+
+            // upper bound of the bucket which includes the percentile (0.0 - 1.0)
+            uint32_t percentile(const float p) const {
+                const uint32_t n = count();
+                if (n == 0) return 0;
+                const uint32_t target = (uint32_t)(p * n + 0.5f);
+                uint32_t acc = 0;
+                for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+                    acc += buckets[i];
+                    if (acc >= target) return upperBound(i);
+                }
+                return upperBound(NUM_BUCKETS - 1);
+            }
+
+            void reset() {
+                for (size_t i = 0; i < NUM_BUCKETS; ++i) buckets[i] = 0;
+            }
+        };
+
+        struct ServerStats {
+            uint32_t packets {0};         // received packets
+            uint32_t bytes {0};           // received bytes
+            uint32_t dropped {0};         // packets which are too large for the receive buffer
+            uint32_t parse_failures {0};  // packets or messages which could not be parsed
+            uint32_t messages {0};        // dispatched messages (including unmatched ones)
+            uint32_t unmatched {0};       // messages which matched no subscription
+            LatencyHistogram latency;     // from parsePacket() to the completion of each callback
+
+            void reset() {
+                packets = bytes = dropped = parse_failures = messages = unmatched = 0;
+                latency.reset();
+            }
+        };
+
+    }  // namespace server
+
+    namespace client {
+
+        // counters of the packets sent to a publish destination
+        // messages sent in a bundle are counted for each destination
+        struct DestinationStats {
+            uint32_t attempts {0};        // packets tried to send
+            uint32_t bytes {0};           // encoded bytes of the attempts
+            uint32_t begin_failures {0};  // beginPacket() failed
+            uint32_t end_failures {0};    // write() or endPacket() failed
+            uint32_t missed_ticks {0};    // publish timings skipped because post() was called too late
+            uint32_t first_us {0};        // micros() of the first attempt
+            uint32_t last_us {0};         // micros() of the last attempt
+
+            uint32_t failures() const { return begin_failures + end_failures; }
+
+            // achieved attempts per second, to be compared with the publish rate (1000000 / interval_us)
+            float rate() const {
+                if ((attempts < 2) || (last_us == first_us)) return 0.f;
+                return (float)(attempts - 1) * 1000000.f / (float)(uint32_t)(last_us - first_us);
+            }
+
+            void reset() {
+                attempts = bytes = begin_failures = end_failures = missed_ticks = 0;
+                first_us = last_us = 0;
+            }
+        };
+
+    }  // namespace client
+}  // namespace osc
+}  // namespace arduino
+
+using OscServerStats = arduino::osc::server::ServerStats;
+using OscLatencyHistogram = arduino::osc::server::LatencyHistogram;
+using OscDestinationStats = arduino::osc::client::DestinationStats;
+
+#endif  // ARDUINOOSC_OSCSTATS_H
@@ -7,6 +7,7 @@
 #include <ArxTypeTraits.h>
 #include <ArxContainer.h>
 #include <DebugLog.h>
+#include "OscArena.h"
 
 #if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
 
@@ -17,7 +18,14 @@ namespace osc {
     template <typename S>
     using UdpRef = std::shared_ptr<S>;
     template <typename S>
-    using UdpMap = std::map<uint16_t, UdpRef<S>>;
+    using UdpMap = std::vector<std::pair<uint16_t, UdpRef<S>>>;  // few ports, searched linearly
+
+    namespace pattern {
+        struct Token;
+        struct CharClass;
+        using TokenList = std::vector<Token>;
+        using CharClassList = std::vector<CharClass>;
+    }  // namespace pattern
 
     namespace message {
         using ArgumentType = std::pair<size_t, size_t>;
@@ -25,31 +33,45 @@ namespace osc {
         class Message;
         using MessageQueue = std::vector<Message>;
     }  // namespace message
-    using BundleData = std::vector<uint32_t>;
     using Blob = std::vector<char>;
 
     namespace client {
         namespace element {
             class Base;
-            using Ref = std::shared_ptr<Base>;
+            using Ref = RefPtr<Base>;
             using TupleRef = std::vector<Ref>;
         }  // namespace element
         class Destination;
         using ElementRef = element::Ref;
         using ElementTupleRef = element::TupleRef;
         using DestinationMap = std::map<Destination, ElementRef>;
+        struct PublishEntry;
+        using PublishHeap = std::vector<PublishEntry>;
+        using PublishBatch = std::vector<PublishEntry>;
+        struct FanoutEndpoint;
+        using FanoutEndpointList = std::vector<FanoutEndpoint>;
+        struct StateEntry;
+        using StateCacheList = std::vector<StateEntry>;
     }  // namespace client
 
     namespace server {
         namespace element {
             class Base;
-            using Ref = std::shared_ptr<Base>;
+            using Ref = RefPtr<Base>;
             using TupleRef = std::vector<Ref>;
             using dummy_vector_t = std::vector<size_t>;
         }  // namespace element
         using ElementRef = element::Ref;
         using ElementTupleRef = element::TupleRef;
-        using CallbackMap = std::map<String, ElementRef>;
+        struct Subscription;
+        using SubscriptionList = std::vector<Subscription>;
+        using SubscriptionIndex = std::vector<uint16_t>;
+        struct ScheduledMessage;
+        struct ScheduleEntry;
+        using ScheduledMessageList = std::vector<ScheduledMessage>;
+        using ScheduleHeap = std::vector<ScheduleEntry>;
+        struct CoalesceSlot;
+        using CoalesceList = std::vector<CoalesceSlot>;
         template <typename S>
         class Server;
         template <typename S>
@@ -84,15 +106,37 @@ namespace osc {
 #ifndef ARDUINOOSC_MAX_SUBSCRIBE_PORTS
 #define ARDUINOOSC_MAX_SUBSCRIBE_PORTS 2
 #endif
-#ifndef ARDUINOOSC_MAX_MSG_BUNDLE_SIZE
-#define ARDUINOOSC_MAX_MSG_BUNDLE_SIZE 128
+#ifndef ARDUINOOSC_MAX_SCHEDULED_MSG_SIZE
+#define ARDUINOOSC_MAX_SCHEDULED_MSG_SIZE 4
+#endif
+#ifndef ARDUINOOSC_MAX_COALESCE_PER_PORT
+#define ARDUINOOSC_MAX_COALESCE_PER_PORT 1
+#endif
+#ifndef ARDUINOOSC_MAX_FANOUT_ENDPOINTS
+#define ARDUINOOSC_MAX_FANOUT_ENDPOINTS 4
+#endif
+#ifndef ARDUINOOSC_MAX_STATE_ENTRIES
+#define ARDUINOOSC_MAX_STATE_ENTRIES 4
+#endif
+#ifndef ARDUINOOSC_MAX_PATTERN_TOKENS
+#define ARDUINOOSC_MAX_PATTERN_TOKENS 8
+#endif
+#ifndef ARDUINOOSC_MAX_PATTERN_CHAR_CLASSES
+#define ARDUINOOSC_MAX_PATTERN_CHAR_CLASSES 1
 #endif
 
     static constexpr uint16_t PORT_DISCARD {9};
     template <typename S>
     using UdpRef = std::shared_ptr<S>;
     template <typename S>
-    using UdpMap = arx::stdx::map<uint16_t, UdpRef<S>, ARDUINOOSC_MAX_SUBSCRIBE_PORTS>;
+    using UdpMap = arx::stdx::vector<arx::stdx::pair<uint16_t, UdpRef<S>>, ARDUINOOSC_MAX_SUBSCRIBE_PORTS>;
+
+    namespace pattern {
+        struct Token;
+        struct CharClass;
+        using TokenList = arx::stdx::vector<Token, ARDUINOOSC_MAX_PATTERN_TOKENS>;
+        using CharClassList = arx::stdx::vector<CharClass, ARDUINOOSC_MAX_PATTERN_CHAR_CLASSES>;
+    }  // namespace pattern
 
     namespace message {
         using ArgumentType = arx::stdx::pair<size_t, size_t>;
@@ -100,33 +144,45 @@ namespace osc {
         class Message;
         using MessageQueue = arx::stdx::vector<Message, ARDUINOOSC_MAX_MSG_QUEUE_SIZE>;
     }  // namespace message
-#ifndef ARDUINOOSC_DISABLE_BUNDLE
-    using BundleData = arx::stdx::vector<uint32_t, ARDUINOOSC_MAX_MSG_BUNDLE_SIZE>;
-#endif
     using Blob = arx::stdx::vector<char, ARDUINOOSC_MAX_MSG_BYTE_SIZE>;
 
     namespace client {
         namespace element {
             class Base;
-            using Ref = std::shared_ptr<Base>;
+            using Ref = RefPtr<Base>;
             using TupleRef = arx::stdx::vector<Ref, ARDUINOOSC_MAX_MSG_ARGUMENT_SIZE>;
         }  // namespace element
         class Destination;
         using ElementRef = element::Ref;
         using ElementTupleRef = element::TupleRef;
         using DestinationMap = arx::stdx::map<Destination, ElementRef, ARDUINOOSC_MAX_PUBLISH_DESTINATION>;
+        struct PublishEntry;
+        using PublishHeap = arx::stdx::vector<PublishEntry, ARDUINOOSC_MAX_PUBLISH_DESTINATION>;
+        using PublishBatch = arx::stdx::vector<PublishEntry, ARDUINOOSC_MAX_PUBLISH_DESTINATION>;
+        struct FanoutEndpoint;
+        using FanoutEndpointList = arx::stdx::vector<FanoutEndpoint, ARDUINOOSC_MAX_FANOUT_ENDPOINTS>;
+        struct StateEntry;
+        using StateCacheList = arx::stdx::vector<StateEntry, ARDUINOOSC_MAX_STATE_ENTRIES>;
     }  // namespace client
 
     namespace server {
         namespace element {
             class Base;
-            using Ref = std::shared_ptr<Base>;
+            using Ref = RefPtr<Base>;
             using TupleRef = arx::stdx::vector<Ref, ARDUINOOSC_MAX_MSG_ARGUMENT_SIZE>;
             using dummy_vector_t = arx::stdx::vector<size_t, ARDUINOOSC_MAX_MSG_ARGUMENT_SIZE>;
         }  // namespace element
         using ElementRef = element::Ref;
         using ElementTupleRef = element::TupleRef;
-        using CallbackMap = arx::stdx::map<String, ElementRef, ARDUINOOSC_MAX_SUBSCRIBE_ADDRESS_PER_PORT>;
+        struct Subscription;
+        using SubscriptionList = arx::stdx::vector<Subscription, ARDUINOOSC_MAX_SUBSCRIBE_ADDRESS_PER_PORT>;
+        using SubscriptionIndex = arx::stdx::vector<uint16_t, ARDUINOOSC_MAX_SUBSCRIBE_ADDRESS_PER_PORT * 4>;
+        struct ScheduledMessage;
+        struct ScheduleEntry;
+        using ScheduledMessageList = arx::stdx::vector<ScheduledMessage, ARDUINOOSC_MAX_SCHEDULED_MSG_SIZE>;
+        using ScheduleHeap = arx::stdx::vector<ScheduleEntry, ARDUINOOSC_MAX_SCHEDULED_MSG_SIZE>;
+        struct CoalesceSlot;
+        using CoalesceList = arx::stdx::vector<CoalesceSlot, ARDUINOOSC_MAX_COALESCE_PER_PORT>;
         template <typename S>
         class Server;
         template <typename S>
@@ -140,6 +196,37 @@ namespace osc {
 
 #endif
 
+// max nesting level of bundles in the encoder and the view decoder
+// ARDUINOOSC_MAX_MSG_BUNDLE_SIZE is the former name of this limit on NO-STL boards, and is still honoured
+#ifndef ARDUINOOSC_MAX_MSG_BUNDLE_DEPTH
+#if defined(ARDUINOOSC_MAX_MSG_BUNDLE_SIZE)
+#define ARDUINOOSC_MAX_MSG_BUNDLE_DEPTH ARDUINOOSC_MAX_MSG_BUNDLE_SIZE
+#elif ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+#define ARDUINOOSC_MAX_MSG_BUNDLE_DEPTH 16
+#else
+#define ARDUINOOSC_MAX_MSG_BUNDLE_DEPTH 4
+#endif
+#endif
+
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+#ifndef ARDUINOOSC_MAX_SCHEDULED_MSG_SIZE
+#define ARDUINOOSC_MAX_SCHEDULED_MSG_SIZE 32
+#endif
+#ifndef ARDUINOOSC_RX_BUFFER_SIZE
+#define ARDUINOOSC_RX_BUFFER_SIZE 1472  // max udp payload in ethernet mtu
+#endif
+#ifndef ARDUINOOSC_PUBLISH_BATCH_MTU
+#define ARDUINOOSC_PUBLISH_BATCH_MTU 1472
+#endif
+#else
+#ifndef ARDUINOOSC_RX_BUFFER_SIZE
+#define ARDUINOOSC_RX_BUFFER_SIZE ARDUINOOSC_MAX_MSG_BYTE_SIZE
+#endif
+#ifndef ARDUINOOSC_PUBLISH_BATCH_MTU
+#define ARDUINOOSC_PUBLISH_BATCH_MTU ARDUINOOSC_MAX_MSG_BYTE_SIZE
+#endif
+#endif
+
 #include "OscUtil.h"
 
 namespace arduino {
@@ -153,7 +240,15 @@ namespace osc {
         TYPE_TAG_FLOAT = 'f',
         TYPE_TAG_DOUBLE = 'd',
         TYPE_TAG_STRING = 's',
-        TYPE_TAG_BLOB = 'b'
+        TYPE_TAG_BLOB = 'b',
+        TYPE_TAG_TIMETAG = 't',
+        TYPE_TAG_CHAR = 'c',
+        TYPE_TAG_RGBA = 'r',
+        TYPE_TAG_MIDI = 'm',
+        TYPE_TAG_NIL = 'N',
+        TYPE_TAG_IMPULSE = 'I',
+        TYPE_TAG_ARRAY_BEGIN = '[',
+        TYPE_TAG_ARRAY_END = ']'
     };
 
     class TimeTag {
@@ -167,6 +262,12 @@ namespace osc {
         operator uint64_t() const { return v; }
         uint64_t value() const { return v; }
         static TimeTag immediate() { return TimeTag(1); }
+        // current time of Clock (defined in OscClock.h), immediate if the clock is not set
+        static TimeTag now();
+        // ntp epoch is 1900-01-01, unix epoch is 1970-01-01
+        static TimeTag fromUnixTime(const uint32_t sec, const uint32_t usec = 0) {
+            return TimeTag((((uint64_t)sec + 2208988800ULL) << 32) | (uint32_t)((((uint64_t)usec) << 32) / 1000000ULL));
+        }
     };
 
     struct Storage {
@@ -204,6 +305,40 @@ namespace osc {
         void clear() { data.clear(); }
     };
 
+    // user provided fixed buffer which can be used in place of Storage, nothing is allocated
+    struct StorageSpan {
+        char* buf {nullptr};
+        size_t cap {0};
+        size_t sz {0};
+
+        StorageSpan() {}
+        StorageSpan(char* buf, const size_t capacity)
+        : buf(buf), cap(capacity) {}
+
+        char* getBytes(const size_t n) {
+            if ((sz & 3) != 0) {
+                LOG_ERROR(F("storage size must be 4x bytes but it is"), sz);
+                return nullptr;
+            }
+            const size_t n4 = ceil4(n);
+            if (!buf || (sz + n4 > cap)) {
+                LOG_ERROR(F("storage size overflow:"), sz + n4, F("must be <="), cap);
+                return nullptr;
+            }
+            char* p = buf + sz;
+            memset(p, 0, n4);  // zero padding
+            sz += n4;
+            return p;
+        }
+        char* begin() { return sz ? buf : nullptr; }
+        char* end() { return begin() ? (begin() + size()) : nullptr; }
+        const char* begin() const { return sz ? buf : nullptr; }
+        const char* end() const { return begin() ? (begin() + size()) : nullptr; }
+        size_t size() const { return sz; }
+        size_t capacity() const { return cap; }
+        void clear() { sz = 0; }
+    };
+
 }  // namespace osc
 }  // namespace arduino
 
@@ -6,6 +6,7 @@
 #include <ArxTypeTraits.h>
 #include <ArxSmartPtr.h>
 #include <ArxContainer.h>
+#include <DebugLog.h>
 
 #include "OscMessage.h"
 #include "OscEncoder.h"
@@ -31,36 +32,29 @@ namespace osc {
             return udp_map;
         }
 
+        // udp is bound once and the returned ref is valid until the end of the program,
+        // so that servers and clients can hold it instead of looking up every time
+        // the ref is null if no more port can be bound (ARDUINOOSC_MAX_SUBSCRIBE_PORTS on NO-STL boards)
         UdpRef<S> getUdp(const uint16_t port) {
-#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
-            using namespace std;
-#else
-            using namespace arx;
-#endif
-            // use first port for PORT_DISCARD if some udp instances exist
-            if (port == PORT_DISCARD) {
-                if (udp_map.empty()) {
-                    udp_map.insert(std::make_pair(port, UdpRef<S>(new S())));
-                    udp_map[port]->begin(port);
-                }
-                return udp_map.begin()->second;
-            }
+            return getOrBind(port, [&](S& udp, const uint16_t p) { udp.begin(p); });
+        }
 
-            if (udp_map.find(port) == udp_map.end()) {
-                // if there is udp listening to port 9, erase it to this port
-                auto udp_discard_ref = udp_map.find(PORT_DISCARD);
-                if (udp_discard_ref != udp_map.end()) {
-                    udp_discard_ref->second->stop();
-                    udp_map.erase(udp_discard_ref);
-                }
-                udp_map.insert(std::make_pair(port, UdpRef<S>(new S())));
-                udp_map[port]->begin(port);
-            }
-            return udp_map[port];
+        UdpRef<S> getMulticastUdp(IPAddress multicast, const uint16_t port, IPAddress iface) {
+            return getOrBind(port, [&](S& udp, const uint16_t p) {
+                udp.beginMulticast(iface, multicast, p);
+                Serial.println("Starting Multicast UDP Server");
+            });
         }
 
-        UdpRef<S> getMulticastUdp(IPAddress multicast, const uint16_t port, IPAddress iface) 
-        {
+    private:
+        UdpRef<S>* find(const uint16_t port) {
+            for (auto& u : udp_map)
+                if (u.first == port) return &u.second;
+            return nullptr;
+        }
+
+        template <typename Bind>
+        UdpRef<S> getOrBind(const uint16_t port, Bind&& bind) {
 #if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
             using namespace std;
 #else
@@ -69,26 +63,35 @@ namespace osc {
             // use first port for PORT_DISCARD if some udp instances exist
             if (port == PORT_DISCARD) {
                 if (udp_map.empty()) {
-                    udp_map.insert(std::make_pair(port, UdpRef<S>(new S())));
-                    udp_map[port]->beginMulticast(iface, multicast, port);
+                    udp_map.push_back(make_pair(port, UdpRef<S>(new S())));
+                    bind(*udp_map.back().second, port);
                 }
-                return udp_map.begin()->second;
+                return udp_map.front().second;
             }
 
-            if (udp_map.find(port) == udp_map.end()) {
-                // if there is udp listening to port 9, erase it to this port
-                auto udp_discard_ref = udp_map.find(PORT_DISCARD);
-                if (udp_discard_ref != udp_map.end()) {
-                    udp_discard_ref->second->stop();
-                    udp_map.erase(udp_discard_ref);
+            if (UdpRef<S>* udp = find(port)) return *udp;
+
+            // if there is udp listening to port 9, rebind it to this port
+            // (the same instance is reused because the clients may hold it)
+            for (auto& u : udp_map) {
+                if (u.first == PORT_DISCARD) {
+                    u.second->stop();
+                    u.first = port;
+                    bind(*u.second, port);
+                    return u.second;
                 }
-                udp_map.insert(std::make_pair(port, UdpRef<S>(new S())));
-                udp_map[port]->beginMulticast(iface, multicast, port);
-                Serial.println("Starting Multicast UDP Server");
             }
-            return udp_map[port];
-        }
 
+#if ARX_HAVE_LIBSTDCPLUSPLUS < 201103L  // Don't have libstdc++11
+            if (udp_map.size() >= udp_map.capacity()) {
+                LOG_ERROR(F("too many udp ports, max is"), udp_map.capacity(), F(", not bound:"), port);
+                return UdpRef<S>();
+            }
+#endif
+            udp_map.push_back(make_pair(port, UdpRef<S>(new S())));
+            bind(*udp_map.back().second, port);
+            return udp_map.back().second;
+        }
     };
 
 }  // namespace osc
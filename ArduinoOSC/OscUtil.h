@@ -19,32 +19,100 @@ namespace osc {
         char bytes[sizeof(T)];
     };
 
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define ARDUINOOSC_BYTE_ORDER_BIG_ENDIAN 1
+#elif defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define ARDUINOOSC_BYTE_ORDER_BIG_ENDIAN 0
+#endif
+
     inline bool isBigEndian() {
+#ifdef ARDUINOOSC_BYTE_ORDER_BIG_ENDIAN
+        return ARDUINOOSC_BYTE_ORDER_BIG_ENDIAN;
+#else
         const PodBytes<int32_t> p {0x12345678};
         return (p.bytes[0] == 0x12);
+#endif
     }
 
+    namespace detail {
+
+        template <size_t N>
+        struct ByteSwap;
+        template <>
+        struct ByteSwap<1> {
+            using type = uint8_t;
+            static type swap(const type v) { return v; }
+        };
+        template <>
+        struct ByteSwap<2> {
+            using type = uint16_t;
+            static type swap(const type v) { return __builtin_bswap16(v); }
+        };
+        template <>
+        struct ByteSwap<4> {
+            using type = uint32_t;
+            static type swap(const type v) { return __builtin_bswap32(v); }
+        };
+        template <>
+        struct ByteSwap<8> {
+            using type = uint64_t;
+            static type swap(const type v) { return __builtin_bswap64(v); }
+        };
+
+        // network (big endian) order <-> host order
+        template <typename U>
+        inline U toHostOrder(const U v) {
+#if defined(ARDUINOOSC_BYTE_ORDER_BIG_ENDIAN) && ARDUINOOSC_BYTE_ORDER_BIG_ENDIAN
+            return v;
+#elif defined(ARDUINOOSC_BYTE_ORDER_BIG_ENDIAN)
+            return ByteSwap<sizeof(U)>::swap(v);
+#else
+            return isBigEndian() ? v : ByteSwap<sizeof(U)>::swap(v);
+#endif
+        }
+
+    }  // namespace detail
+
+    // the bytes are loaded and stored at once by memcpy, so they can be unaligned
     template <typename POD>
     inline POD bytes2pod(const char* bytes) {
-        PodBytes<POD> p;
-        for (size_t i = 0; i < sizeof(POD); ++i) {
-            if (isBigEndian())
-                p.bytes[i] = bytes[i];
-            else
-                p.bytes[i] = bytes[sizeof(POD) - i - 1];
-        }
-        return p.value;
+        using U = typename detail::ByteSwap<sizeof(POD)>::type;
+        U u;
+        memcpy(&u, bytes, sizeof(U));
+        u = detail::toHostOrder(u);
+        POD value;
+        memcpy(&value, &u, sizeof(POD));
+        return value;
     }
 
     template <typename POD>
     inline void pod2bytes(const POD& value, char* bytes) {
-        const PodBytes<POD> p {value};
-        for (size_t i = 0; i < sizeof(POD); ++i) {
-            if (isBigEndian())
-                bytes[i] = p.bytes[i];
-            else
-                bytes[i] = p.bytes[sizeof(POD) - i - 1];
+        using U = typename detail::ByteSwap<sizeof(POD)>::type;
+        U u;
+        memcpy(&u, &value, sizeof(POD));
+        u = detail::toHostOrder(u);
+        memcpy(bytes, &u, sizeof(U));
+    }
+
+    // batch conversion of the contiguous values (e.g. array of floats in the blob)
+    template <typename POD>
+    inline void bytes2pods(const char* bytes, POD* values, const size_t n) {
+        for (size_t i = 0; i < n; ++i) values[i] = bytes2pod<POD>(bytes + i * sizeof(POD));
+    }
+
+    template <typename POD>
+    inline void pods2bytes(const POD* values, char* bytes, const size_t n) {
+        for (size_t i = 0; i < n; ++i) pod2bytes<POD>(values[i], bytes + i * sizeof(POD));
+    }
+
+    // FNV-1a, pass the previous hash to continue hashing
+    inline uint32_t fnv1a(const void* data, const size_t len, uint32_t h = 2166136261UL) {
+        const uint8_t* p = (const uint8_t*)data;
+        for (size_t i = 0; i < len; ++i) {
+            h ^= p[i];
+            h *= 16777619UL;
         }
+        return h;
     }
 
     inline const char* internalPatternMatch(const char* pattern, const char* path) {
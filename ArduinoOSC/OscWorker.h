@@ -0,0 +1,159 @@
+#pragma once
+
+#ifndef ARDUINOOSC_OSCWORKER_H
+#define ARDUINOOSC_OSCWORKER_H
+
+#include <Arduino.h>
+#include <ArxTypeTraits.h>
+#include "OscTypes.h"
+#include "OscRing.h"
+#include "OscMessage.h"
+#include "OscMessageView.h"
+
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+
+#include <atomic>
+
+#ifndef ARDUINOOSC_WORKER_QUEUE_SIZE
+#define ARDUINOOSC_WORKER_QUEUE_SIZE 16  // messages per worker, must be power of 2
+#endif
+#ifndef ARDUINOOSC_WORKER_MSG_SIZE
+#define ARDUINOOSC_WORKER_MSG_SIZE 256  // max encoded size of a queued message
+#endif
+
+namespace arduino {
+namespace osc {
+    namespace server {
+
+        // matched message and the subscribed element to be called in the worker
+        // subscriptions are never removed, so the element is referred by the raw pointer
+        struct DispatchJob {
+            element::Base* ref {nullptr};
+            TimeTag time_tag;
+            IPAddress ip;
+            uint16_t port {0};
+            uint16_t size {0};
+            alignas(4) char data[ARDUINOOSC_WORKER_MSG_SIZE];
+        };
+
+        // calls the callbacks of the messages posted by servers (on other tasks / cores)
+        // Server::useWorkers() posts the matched messages here instead of calling the callbacks in parse()
+        // drain() is called by the FreeRTOS task started by begin() (ESP32), or by yourself
+        class DispatchWorker {
+            MpscQueue<DispatchJob, ARDUINOOSC_WORKER_QUEUE_SIZE> queue;
+            std::atomic<uint32_t> num_posted {0};
+            std::atomic<uint32_t> num_dropped {0};    // queue was full
+            std::atomic<uint32_t> num_oversized {0};  // message was larger than ARDUINOOSC_WORKER_MSG_SIZE
+#if defined(ESP_PLATFORM)
+            TaskHandle_t task {nullptr};
+#endif
+
+        public:
+            DispatchWorker() {}
+            DispatchWorker(const DispatchWorker&) = delete;
+            DispatchWorker& operator=(const DispatchWorker&) = delete;
+
+#if defined(ESP_PLATFORM)
+            // start the task pinned to the core, which waits for the posted messages
+            bool begin(const BaseType_t core = 1, const UBaseType_t priority = 1, const uint32_t stack_size = 4096, const char* name = "osc_worker") {
+                if (task) return true;
+                return xTaskCreatePinnedToCore(&DispatchWorker::run, name, stack_size, this, priority, &task, core) == pdPASS;
+            }
+            TaskHandle_t getTaskHandle() const { return task; }
+#endif
+
+            // the view must be a single message (not a bundle), returns false if it is dropped
+            bool post(element::Base* ref, const MessageView& v) {
+                if (v.dataSize() > ARDUINOOSC_WORKER_MSG_SIZE) {
+                    num_oversized.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                size_t ticket;
+                DispatchJob* job = queue.reserve(ticket);
+                if (!job) {
+                    num_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                memcpy(job->data, v.data(), v.dataSize());
+                job->size = (uint16_t)v.dataSize();
+                set(*job, ref, v.timeTag(), v.remoteIP(), v.remotePort());
+                commit(ticket);
+                return true;
+            }
+
+            bool post(element::Base* ref, const Message& m) {
+                if (m.encodedSize() > ARDUINOOSC_WORKER_MSG_SIZE) {
+                    num_oversized.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                size_t ticket;
+                DispatchJob* job = queue.reserve(ticket);
+                if (!job) {
+                    num_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                StorageSpan span(job->data, sizeof(job->data));
+                if (!m.encode(span)) {
+                    // give the cell back as an empty job to keep the order of tickets
+                    job->ref = nullptr;
+                    queue.commit(ticket);
+                    num_oversized.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                job->size = (uint16_t)span.size();
+                set(*job, ref, m.timeTag(), m.remoteAddress(), m.remotePort());
+                commit(ticket);
+                return true;
+            }
+
+            // call the callbacks of the posted messages (up to max_jobs, 0 means all of them)
+            // must be called from only one task at a time, returns the number of called callbacks
+            // defined in OSCServer.h because element::Base is needed
+            size_t drain(const size_t max_jobs = 0);
+
+            size_t pending() const { return queue.size(); }
+            uint32_t posted() const { return num_posted.load(std::memory_order_relaxed); }
+            uint32_t dropped() const { return num_dropped.load(std::memory_order_relaxed); }
+            uint32_t oversized() const { return num_oversized.load(std::memory_order_relaxed); }
+            void resetStats() {
+                num_posted.store(0, std::memory_order_relaxed);
+                num_dropped.store(0, std::memory_order_relaxed);
+                num_oversized.store(0, std::memory_order_relaxed);
+            }
+
+        private:
+            static void set(DispatchJob& job, element::Base* ref, const TimeTag& tt, const IPAddress& ip, const uint16_t port) {
+                job.ref = ref;
+                job.time_tag = tt;
+                job.ip = ip;
+                job.port = port;
+            }
+
+            void commit(const size_t ticket) {
+                queue.commit(ticket);
+                num_posted.fetch_add(1, std::memory_order_relaxed);
+#if defined(ESP_PLATFORM)
+                if (task) xTaskNotifyGive(task);
+#endif
+            }
+
+#if defined(ESP_PLATFORM)
+            static void run(void* arg) {
+                DispatchWorker* self = (DispatchWorker*)arg;
+                while (true) {
+                    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                    self->drain();
+                }
+            }
+#endif
+        };
+
+    }  // namespace server
+}  // namespace osc
+}  // namespace arduino
+
+using OscDispatchWorker = arduino::osc::server::DispatchWorker;
+
+#endif  // Have libstdc++11
+
+#endif  // ARDUINOOSC_OSCWORKER_H
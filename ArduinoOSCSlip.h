@@ -0,0 +1,14 @@
+#pragma once
+#ifndef ARDUINOOSCSLIP_H
+#define ARDUINOOSCSLIP_H
+
+#include <Arduino.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include "ArduinoOSC/OscSlip.h"
+using OscSlipStream = OscSlipTransport<Stream>;
+using OscSlipManager = ArduinoOSC::Manager<OscSlipStream>;
+#define OscSlip OscSlipManager::getInstance()
+using OscSlipServer = OscServer<OscSlipStream>;
+using OscSlipClient = OscClient<OscSlipStream>;
+
+#endif  // ARDUINOOSCSLIP_H
@@ -31,6 +31,15 @@ using OscWiFiManager = ArduinoOSC::Manager<WiFiUDP>;
 #define OscWiFi OscWiFiManager::getInstance()
 using OscWiFiServer = OscServer<WiFiUDP>;
 using OscWiFiClient = OscClient<WiFiUDP>;
+#if defined(ESP_PLATFORM)
+#include <AsyncUDP.h>
+#include "ArduinoOSC/OscAsyncUdp.h"
+using OscAsyncUDP = OscAsyncUdpTransport<AsyncUDP, AsyncUDPPacket>;
+using OscAsyncWiFiManager = ArduinoOSC::Manager<OscAsyncUDP>;
+#define OscAsyncWiFi OscAsyncWiFiManager::getInstance()
+using OscAsyncWiFiServer = OscServer<OscAsyncUDP>;
+using OscAsyncWiFiClient = OscClient<OscAsyncUDP>;
+#endif
 #endif  // ARDUINOOSC_ENABLE_WIFI
 
 #endif  // ARDUINOOSCWIFI_H
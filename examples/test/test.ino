@@ -80,6 +80,31 @@ void basicTests() {
         Serial.println((f2 == 5.678f) ? "Success" : "Failed");
     }
 
+    wr.init().begin_bundle();
+    wr.encode(msg.init("/foo").push(1000).push(-1).push("hello").push(1.234f).push(5.678f));
+    wr.end_bundle();
+
+    OscViewDecoder vr(wr.data(), wr.size());
+
+    Serial.println("argument view decode test: ");
+    const OscMessageView* mv = vr.decode();
+    {
+        Serial.print("address: ");
+        Serial.println((mv && mv->match("/foo")) ? "Success" : "Failed");
+        Serial.print("int1   : ");
+        Serial.println((mv->arg<int32_t>(0) == 1000) ? "Success" : "Failed");
+        Serial.print("int2   : ");
+        Serial.println((mv->arg<int32_t>(1) == -1) ? "Success" : "Failed");
+        Serial.print("String : ");
+        Serial.println((strcmp(mv->getArgAsCString(2), "hello") == 0) ? "Success" : "Failed");
+        Serial.print("float1 : ");
+        Serial.println((mv->arg<float>(3) == 1.234f) ? "Success" : "Failed");
+        Serial.print("float2 : ");
+        Serial.println((mv->arg<float>(4) == 5.678f) ? "Success" : "Failed");
+        Serial.print("end    : ");
+        Serial.println((vr.decode() == nullptr) ? "Success" : "Failed");
+    }
+
     wr.init().begin_bundle().begin_bundle().end_bundle().end_bundle();
     hexdump(wr.data(), wr.size(), 0);
     Serial.print("Bundle encode : ");
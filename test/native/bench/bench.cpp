@@ -0,0 +1,136 @@
+// ns/msg of the hot paths: encode, decode, pattern match and Server::parse dispatch
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace arduino::osc;
+using namespace arduino::osc::message;
+using M = ArduinoOSC::Manager<MockUdp>;
+
+template <typename F>
+static double measure(const size_t n, F&& f) {
+    const auto begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i) f(i);
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / (double)n;
+}
+
+static void report(const char* name, const double ns) {
+    printf("%-48s %10.1f ns/msg\n", name, ns);
+}
+
+// keep the result alive so that the compiler does not remove the measured code
+static volatile size_t sink;
+
+static void benchEncode() {
+    Message m("/bench/encode");
+    m.pushInt32(123).pushFloat(4.5f).pushString("string payload");
+    Encoder e;
+    report("Message::encode (i f s)", measure(1000000, [&](size_t) {
+        e.init().encode(m);
+        sink = e.size();
+    }));
+
+    uint8_t buf[256];
+    SpanEncoder se(buf, sizeof(buf));
+    report("Message::encode into span (i f s)", measure(1000000, [&](size_t) {
+        se.init().encode(m);
+        sink = se.size();
+    }));
+}
+
+static void benchDecode() {
+    Message m("/bench/decode");
+    m.pushInt32(123).pushFloat(4.5f).pushString("string payload");
+    Encoder e;
+    e.encode(m);
+    const std::vector<uint8_t> packet(e.data(), e.data() + e.size());
+
+    Decoder d;
+    report("Decoder::init (i f s)", measure(1000000, [&](size_t) {
+        d.init(packet.data(), packet.size());
+        sink = d.decode()->size();
+    }));
+
+    ViewDecoder vd;
+    report("ViewDecoder::init (i f s)", measure(1000000, [&](size_t) {
+        vd.init(packet.data(), packet.size());
+        sink = vd.decode()->size();
+    }));
+
+    Encoder eb;
+    eb.begin_bundle();
+    for (int i = 0; i < 10; ++i) eb.encode(m);
+    eb.end_bundle();
+    const std::vector<uint8_t> bundle(eb.data(), eb.data() + eb.size());
+    report("Decoder::init (bundle of 10, per msg)", measure(100000, [&](size_t) {
+        d.init(bundle.data(), bundle.size());
+        while (Message* p = d.decode()) sink = p->size();
+    }) / 10.0);
+}
+
+static void benchPatternMatch() {
+    report("internalPatternMatch exact", measure(1000000, [&](size_t) {
+        sink = (size_t)internalPatternMatch("/mixer/channel/12/fader", "/mixer/channel/12/fader");
+    }));
+    report("internalPatternMatch /mixer/*/12/{fader,mute}", measure(1000000, [&](size_t) {
+        sink = (size_t)internalPatternMatch("/mixer/*/12/{fader,mute}", "/mixer/channel/12/fader");
+    }));
+    report("internalPatternMatch //fader", measure(1000000, [&](size_t) {
+        sink = (size_t)internalPatternMatch("//fader", "/mixer/channel/12/fader");
+    }));
+
+    const OscPattern p1("/mixer/*/12/{fader,mute}"), p2("//fader");
+    report("Pattern::match /mixer/*/12/{fader,mute}", measure(1000000, [&](size_t) {
+        sink = p1.match("/mixer/channel/12/fader", 23);
+    }));
+    report("Pattern::match //fader", measure(1000000, [&](size_t) {
+        sink = p2.match("/mixer/channel/12/fader", 23);
+    }));
+}
+
+// subscribe n addresses on the port and dispatch packets to them in turn
+static void benchDispatch(const uint16_t port, const size_t n, const bool pattern, const bool view) {
+    auto& osc = M::getInstance();
+    auto& server = osc.getServer(port);
+    server.useMessageView(view);
+    static int value = 0;
+    (void)value;
+    for (size_t i = 0; i < n; ++i) {
+        const String addr = String("/bench/") + String((unsigned)i) + (pattern ? "/*" : "/value");
+        server.subscribe(addr, [](int v) { value = v; });
+    }
+
+    const size_t num_packets = 20000;
+    std::vector<std::vector<uint8_t>> packets;
+    for (size_t i = 0; i < 16; ++i) {
+        Message m(String("/bench/") + String((unsigned)((i * 7919) % n)) + "/value");
+        m.pushInt32((int32_t)i);
+        Encoder e;
+        e.encode(m);
+        packets.emplace_back(e.data(), e.data() + e.size());
+    }
+    auto& q = mock_net()[port];
+    for (size_t i = 0; i < num_packets; ++i) q.push_back({packets[i % packets.size()], IPAddress(127, 0, 0, 1), 9});
+
+    char name[64];
+    snprintf(name, sizeof(name), "Server::parse %4zu %s%s", n, pattern ? "patterns" : "addresses", view ? " (view)" : "");
+    report(name, measure(num_packets, [&](size_t) {
+        server.parse();
+    }));
+}
+
+int main() {
+    benchEncode();
+    benchDecode();
+    benchPatternMatch();
+    uint16_t port = 51000;
+    for (const size_t n : {1, 10, 100, 1000}) {
+        benchDispatch(port++, n, false, false);
+        benchDispatch(port++, n, false, true);
+    }
+    for (const size_t n : {1, 10, 100, 1000}) benchDispatch(port++, n, true, false);
+    return 0;
+}
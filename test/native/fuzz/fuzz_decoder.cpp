@@ -0,0 +1,76 @@
+// libFuzzer entry point over Decoder::init() and ViewDecoder::init()
+//   clang++ -fsanitize=fuzzer,address ... fuzz_decoder.cpp
+// built with -DFUZZ_STANDALONE, the inputs are read from the files in the arguments instead
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+
+using namespace arduino::osc;
+using namespace arduino::osc::message;
+
+static void touch(const Message& m) {
+    const char* tags = m.typeTags().c_str();
+    for (size_t i = 0; i < m.size(); ++i) {
+        switch (tags[i]) {
+            case TYPE_TAG_TRUE:
+            case TYPE_TAG_FALSE: (void)m.getArgAsBool(i); break;
+            case TYPE_TAG_INT32: (void)m.getArgAsInt32(i); break;
+            case TYPE_TAG_INT64: (void)m.getArgAsInt64(i); break;
+            case TYPE_TAG_FLOAT: (void)m.getArgAsFloat(i); break;
+            case TYPE_TAG_DOUBLE: (void)m.getArgAsDouble(i); break;
+            case TYPE_TAG_STRING: (void)m.getArgAsString(i); break;
+            case TYPE_TAG_BLOB: (void)m.getArgAsBlob(i); break;
+            default: break;
+        }
+    }
+}
+
+static void touchView(const MessageView& m) {
+    const char* tags = m.typeTags();
+    size_t n = 0;
+    for (size_t i = 0; i < m.size(); ++i) {
+        switch (tags[i]) {
+            case TYPE_TAG_INT32: (void)m.arg<int32_t>(i); break;
+            case TYPE_TAG_INT64: (void)m.arg<int64_t>(i); break;
+            case TYPE_TAG_FLOAT: (void)m.arg<float>(i); break;
+            case TYPE_TAG_DOUBLE: (void)m.arg<double>(i); break;
+            case TYPE_TAG_STRING: (void)m.arg<String>(i); break;
+            case TYPE_TAG_BLOB: (void)m.getArgAsBlobPtr(i, n); break;
+            default: break;
+        }
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    // the decoders read the packet in place, so copy it into the aligned buffer as the server does
+    static uint8_t buffer[ARDUINOOSC_RX_BUFFER_SIZE];
+    if (size > sizeof(buffer)) return 0;
+    if (size) memcpy(buffer, data, size);
+
+    static Decoder decoder;
+    if (decoder.init(buffer, size)) {
+        while (Message* m = decoder.decode())
+            if (m->available()) touch(*m);
+    }
+
+    ViewDecoder view_decoder;
+    if (view_decoder.init(buffer, size)) {
+        while (MessageView* v = view_decoder.decode())
+            if (v->available()) touchView(*v);
+    }
+    return 0;
+}
+
+#ifdef FUZZ_STANDALONE
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        std::ifstream f(argv[i], std::ios::binary);
+        std::vector<uint8_t> v((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+        LLVMFuzzerTestOneInput(v.data(), v.size());
+    }
+    return 0;
+}
+#endif
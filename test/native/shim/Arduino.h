@@ -0,0 +1,104 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <chrono>
+#include <thread>
+
+class __FlashStringHelper;
+#define F(s) (s)
+#define PROGMEM
+
+class String {
+    std::string s;
+public:
+    String() {}
+    String(const char* c) : s(c ? c : "") {}
+    String(const std::string& c) : s(c) {}
+    String(char c) : s(1, c) {}
+    String(int v) : s(std::to_string(v)) {}
+    String(unsigned v) : s(std::to_string(v)) {}
+    String(long v) : s(std::to_string(v)) {}
+    String(unsigned long v) : s(std::to_string(v)) {}
+    String(unsigned char v) : s(std::to_string(v)) {}
+    String(float v) : s(std::to_string(v)) {}
+    String(double v) : s(std::to_string(v)) {}
+    size_t length() const { return s.length(); }
+    const char* c_str() const { return s.c_str(); }
+    bool reserve(size_t n) { s.reserve(n); return true; }
+    String& operator+=(const String& o) { s += o.s; return *this; }
+    String& operator+=(const char* o) { s += o; return *this; }
+    String& operator+=(char c) { s += c; return *this; }
+    bool concat(const char* c, size_t n) { s.append(c, n); return true; }
+    bool concat(char c) { s += c; return true; }
+    friend String operator+(const String& a, const String& b) { return String(a.s + b.s); }
+    friend String operator+(const char* a, const String& b) { return String(std::string(a) + b.s); }
+    friend String operator+(const String& a, const char* b) { return String(a.s + b); }
+    bool operator==(const String& o) const { return s == o.s; }
+    bool operator==(const char* o) const { return s == o; }
+    bool operator!=(const String& o) const { return s != o.s; }
+    bool operator<(const String& o) const { return s < o.s; }
+    char operator[](size_t i) const { return i < s.size() ? s[i] : 0; }
+    char& operator[](size_t i) { return s[i]; }
+    void remove(size_t i) { s.erase(i); }
+    void remove(size_t i, size_t n) { s.erase(i, n); }
+    int indexOf(char c, size_t from = 0) const { auto p = s.find(c, from); return p == std::string::npos ? -1 : (int)p; }
+    String substring(size_t a) const { return String(s.substr(a)); }
+    String substring(size_t a, size_t b) const { return String(s.substr(a, b - a)); }
+    bool startsWith(const String& p) const { return s.rfind(p.s, 0) == 0; }
+    long toInt() const { return atol(s.c_str()); }
+};
+
+class IPAddress {
+    uint8_t b[4] {0, 0, 0, 0};
+public:
+    IPAddress() {}
+    IPAddress(uint8_t a, uint8_t c, uint8_t d, uint8_t e) : b {a, c, d, e} {}
+    IPAddress(uint32_t v) { memcpy(b, &v, 4); }
+    IPAddress(int v) : IPAddress((uint32_t)v) {}
+    IPAddress(const char* s) { fromString(s); }
+    bool fromString(const char* s) {
+        unsigned v[4];
+        if (sscanf(s, "%u.%u.%u.%u", &v[0], &v[1], &v[2], &v[3]) != 4) return false;
+        for (int i = 0; i < 4; ++i) b[i] = (uint8_t)v[i];
+        return true;
+    }
+    bool fromString(const String& s) { return fromString(s.c_str()); }
+    operator uint32_t() const { uint32_t v; memcpy(&v, b, 4); return v; }
+    uint8_t operator[](int i) const { return b[i]; }
+    uint8_t& operator[](int i) { return b[i]; }
+    bool operator==(const IPAddress& o) const { return memcmp(b, o.b, 4) == 0; }
+    bool operator!=(const IPAddress& o) const { return !(*this == o); }
+    String toString() const { char t[16]; snprintf(t, sizeof(t), "%u.%u.%u.%u", b[0], b[1], b[2], b[3]); return String(t); }
+};
+
+inline uint32_t mock_micros_offset(int32_t add = 0) { static uint32_t o = 0; o += add; return o; }
+inline uint32_t micros() {
+    static auto t0 = std::chrono::steady_clock::now();
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count() + mock_micros_offset();
+}
+inline uint32_t millis() { return micros() / 1000; }
+inline void delay(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+inline void delayMicroseconds(uint32_t us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+
+struct MockSerial {
+    void print(const String& s) { fputs(s.c_str(), stdout); }
+    void print(const char* s) { fputs(s, stdout); }
+    void print(char c) { fputc(c, stdout); }
+    void print(int v) { printf("%d", v); }
+    void print(unsigned v) { printf("%u", v); }
+    void print(long v) { printf("%ld", v); }
+    void print(unsigned long v) { printf("%lu", v); }
+    void print(long long v) { printf("%lld", v); }
+    void print(unsigned long long v) { printf("%llu", v); }
+    void print(double v) { printf("%.2f", v); }
+    void print(const IPAddress& ip) { print(ip.toString()); }
+    template <typename T> void println(const T& t) { print(t); fputc('\n', stdout); }
+    void println() { fputc('\n', stdout); }
+    void begin(long) {}
+};
+static MockSerial Serial;
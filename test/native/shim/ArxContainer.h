@@ -0,0 +1,73 @@
+#pragma once
+#include <vector>
+#include <map>
+#include <deque>
+#include <utility>
+#ifdef MOCK_NOSTL
+// bounded like ArxContainer: elements beyond the capacity N are not added, so the overflow paths of the NO-STL build run
+namespace arx { namespace stdx {
+template <class T, size_t N = 16> struct vector : std::vector<T> {
+    using base = std::vector<T>;
+    using typename base::iterator;
+    using typename base::const_iterator;
+    using base::base;
+    size_t capacity() const { return N; }
+    size_t max_size() const { return N; }
+    bool full() const { return this->size() >= N; }
+    void push_back(const T& v) { if (!full()) base::push_back(v); }
+    void push_back(T&& v) { if (!full()) base::push_back(std::move(v)); }
+    template <class... A> void emplace_back(A&&... a) { if (!full()) base::emplace_back(std::forward<A>(a)...); }
+    template <class... A> iterator emplace(const_iterator pos, A&&... a) {
+        if (full()) return this->begin() + (pos - this->cbegin());
+        return base::emplace(pos, std::forward<A>(a)...);
+    }
+    iterator insert(const_iterator pos, const T& v) { return emplace(pos, v); }
+    iterator insert(const_iterator pos, T&& v) { return emplace(pos, std::move(v)); }
+    template <class It> iterator insert(const_iterator pos, It first, It last) {
+        const size_t i = pos - this->cbegin();
+        for (; (first != last) && !full(); ++first, ++pos) pos = emplace(pos, *first);
+        return this->begin() + i;
+    }
+};
+template <class K, class V, size_t N = 16> struct map : std::map<K, V> {
+    using base = std::map<K, V>;
+    using typename base::iterator;
+    using typename base::value_type;
+    using base::base;
+    size_t capacity() const { return N; }
+    size_t max_size() const { return N; }
+    bool full() const { return this->size() >= N; }
+    std::pair<iterator, bool> insert(const value_type& v) {
+        if (full() && (this->find(v.first) == this->end())) return {this->end(), false};
+        return base::insert(v);
+    }
+    std::pair<iterator, bool> insert(value_type&& v) {
+        if (full() && (this->find(v.first) == this->end())) return {this->end(), false};
+        return base::insert(std::move(v));
+    }
+    template <class... A> std::pair<iterator, bool> emplace(A&&... a) { return insert(value_type(std::forward<A>(a)...)); }
+    // the new key of the full map gets the dummy value which is not kept
+    V& operator[](const K& k) {
+        auto it = this->find(k);
+        if (it != this->end()) return it->second;
+        if (full()) { static V dummy; dummy = V(); return dummy; }
+        return base::operator[](k);
+    }
+};
+template <class T, size_t N = 16> struct deque : std::deque<T> {
+    using base = std::deque<T>;
+    using base::base;
+    size_t capacity() const { return N; }
+    size_t max_size() const { return N; }
+    bool full() const { return this->size() >= N; }
+    void push_back(const T& v) { if (!full()) base::push_back(v); }
+    void push_back(T&& v) { if (!full()) base::push_back(std::move(v)); }
+    void push_front(const T& v) { if (!full()) base::push_front(v); }
+    void push_front(T&& v) { if (!full()) base::push_front(std::move(v)); }
+    template <class... A> void emplace_back(A&&... a) { if (!full()) base::emplace_back(std::forward<A>(a)...); }
+    template <class... A> void emplace_front(A&&... a) { if (!full()) base::emplace_front(std::forward<A>(a)...); }
+};
+using std::pair;
+using std::make_pair;
+}}
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+#ifdef MOCK_NOSTL
+#define ARX_HAVE_LIBSTDCPLUSPLUS 0
+#else
+#define ARX_HAVE_LIBSTDCPLUSPLUS 201703L
+#endif
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+namespace std {
+#if __cplusplus < 202002L
+template <class T> struct remove_cvref { using type = std::remove_cv_t<std::remove_reference_t<T>>; };
+template <class T> using remove_cvref_t = typename remove_cvref<T>::type;
+#endif
+}
+namespace arx {
+namespace detail {
+template <typename T> struct ft;
+template <typename R, typename... A> struct ft<R(A...)> { using function = std::function<R(A...)>; };
+template <typename R, typename... A> struct ft<R (*)(A...)> : ft<R(A...)> {};
+template <typename C, typename R, typename... A> struct ft<R (C::*)(A...)> : ft<R(A...)> {};
+template <typename C, typename R, typename... A> struct ft<R (C::*)(A...) const> : ft<R(A...)> {};
+template <typename F, typename = void> struct ftf : ft<decltype(&F::operator())> {};
+template <typename R, typename... A> struct ftf<R(A...), void> : ft<R(A...)> {};
+template <typename R, typename... A> struct ftf<R (*)(A...), void> : ft<R(A...)> {};
+}
+template <typename F> struct function_traits {
+    using function = typename detail::ftf<std::decay_t<F>>::function;
+    static function cast(const F& f) { return function(f); }
+};
+template <typename T, typename = void> struct is_callable : std::false_type {};
+template <typename T> struct is_callable<T, std::enable_if_t<std::is_function<std::remove_pointer_t<std::decay_t<T>>>::value>> : std::true_type {};
+template <typename T> struct is_callable<T, std::void_t<decltype(&std::decay_t<T>::operator())>> : std::true_type {};
+}
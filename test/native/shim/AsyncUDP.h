@@ -0,0 +1,54 @@
+#pragma once
+// minimal AsyncUDP of arduino-esp32, packets written to a port are delivered to its listener in the caller thread
+#include <Arduino.h>
+#include <map>
+#include <mutex>
+
+class AsyncUDPPacket {
+    const uint8_t* d; size_t n; IPAddress ip; uint16_t p;
+public:
+    AsyncUDPPacket(const uint8_t* d, size_t n, IPAddress ip, uint16_t p) : d(d), n(n), ip(ip), p(p) {}
+    uint8_t* data() { return (uint8_t*)d; }
+    size_t length() { return n; }
+    IPAddress remoteIP() { return ip; }
+    uint16_t remotePort() { return p; }
+};
+
+typedef void (*AuPacketHandlerFunctionWithArg)(void* arg, AsyncUDPPacket& packet);
+
+class AsyncUDP;
+inline std::map<uint16_t, AsyncUDP*>& mock_async_net() { static auto* n = new std::map<uint16_t, AsyncUDP*>(); return *n; }  // outlives the udp map
+inline std::mutex& mock_async_mutex() { static auto* m = new std::mutex(); return *m; }
+
+class AsyncUDP {
+    uint16_t port_ {0};
+    AuPacketHandlerFunctionWithArg cb {nullptr};
+    void* arg {nullptr};
+public:
+    ~AsyncUDP() { close(); }
+    bool listen(uint16_t p) { std::lock_guard<std::mutex> l(mock_async_mutex()); port_ = p; mock_async_net()[p] = this; return true; }
+    bool listenMulticast(const IPAddress&, uint16_t p) { return listen(p); }
+    void onPacket(AuPacketHandlerFunctionWithArg f, void* a = nullptr) { cb = f; arg = a; }
+    void close() {
+        std::lock_guard<std::mutex> l(mock_async_mutex());
+        auto it = mock_async_net().find(port_);
+        if ((it != mock_async_net().end()) && (it->second == this)) mock_async_net().erase(it);
+    }
+    size_t writeTo(const uint8_t* data, size_t len, const IPAddress&, uint16_t p) {
+        mock_async_deliver(data, len, IPAddress(127, 0, 0, 1), port_, p);
+        return len;  // delivered or lost as udp
+    }
+    // delivers the datagram to the listener of the port as if the network task received it
+    static bool mock_async_deliver(const uint8_t* data, size_t len, IPAddress ip, uint16_t from, uint16_t to) {
+        AsyncUDP* u = nullptr;
+        {
+            std::lock_guard<std::mutex> l(mock_async_mutex());
+            auto it = mock_async_net().find(to);
+            if (it != mock_async_net().end()) u = it->second;
+        }
+        if (!u || !u->cb) return false;
+        AsyncUDPPacket packet(data, len, ip, from);
+        u->cb(u->arg, packet);
+        return true;
+    }
+};
@@ -0,0 +1,3 @@
+#pragma once
+#include <MockUdp.h>
+using EthernetUDP = MockUdp;
@@ -0,0 +1,50 @@
+#pragma once
+#include <Arduino.h>
+#include <deque>
+#include <map>
+#include <vector>
+
+struct MockDatagram { std::vector<uint8_t> data; IPAddress ip; uint16_t port; };
+inline std::map<uint16_t, std::deque<MockDatagram>>& mock_net() { static std::map<uint16_t, std::deque<MockDatagram>> n; return n; }
+// datagrams waiting on the port, and take the oldest one (the port must not be empty)
+inline size_t mock_pending(uint16_t port) { return mock_net()[port].size(); }
+inline MockDatagram mock_pop(uint16_t port) { MockDatagram d = std::move(mock_net()[port].front()); mock_net()[port].pop_front(); return d; }
+
+class MockUdp {
+    uint16_t port_ {0};
+    MockDatagram rx;
+    size_t rx_pos {0};
+    std::vector<uint8_t> tx;
+    uint16_t tx_port {0};
+public:
+    static int& fail_end() { static int f = 0; return f; }
+    static int& fail_begin() { static int f = 0; return f; }
+    uint8_t begin(uint16_t p) { port_ = p; return 1; }
+    uint8_t beginMulticast(IPAddress, IPAddress, uint16_t p) { port_ = p; return 1; }
+    void stop() {}
+    int parsePacket() {
+        auto& q = mock_net()[port_];
+        if (q.empty()) return 0;
+        rx = std::move(q.front()); q.pop_front(); rx_pos = 0;
+        return (int)rx.data.size();
+    }
+    int available() { return (int)(rx.data.size() - rx_pos); }
+    int read(uint8_t* b, size_t n) {
+        size_t k = std::min(n, rx.data.size() - rx_pos);
+        memcpy(b, rx.data.data() + rx_pos, k); rx_pos += k; return (int)k;
+    }
+    int read(char* b, size_t n) { return read((uint8_t*)b, n); }
+    IPAddress remoteIP() { return rx.ip; }
+    uint16_t remotePort() { return rx.port; }
+    uint16_t localPort() { return port_; }
+    int beginPacket(const char*, uint16_t p) { if (fail_begin() > 0) { --fail_begin(); return 0; } tx.clear(); tx_port = p; return 1; }
+    int beginPacket(IPAddress, uint16_t p) { if (fail_begin() > 0) { --fail_begin(); return 0; } tx.clear(); tx_port = p; return 1; }
+    static IPAddress& last_iface() { static IPAddress i; return i; }
+    int beginPacketMulticast(IPAddress, uint16_t p, IPAddress iface, int = 1) { last_iface() = iface; tx.clear(); tx_port = p; return 1; }
+    size_t write(const uint8_t* b, size_t n) { tx.insert(tx.end(), b, b + n); return n; }
+    size_t write(uint8_t c) { tx.push_back(c); return 1; }
+    int endPacket() {
+        if (fail_end() > 0) { --fail_end(); return 0; }
+        mock_net()[tx_port].push_back({tx, IPAddress(127, 0, 0, 1), port_}); return 1;
+    }
+};
@@ -0,0 +1,81 @@
+// AsyncUdpTransport: datagrams pushed from the network thread are dispatched through the SpscRing
+#include <AsyncUDP.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include "ArduinoOSC/OscAsyncUdp.h"
+#include <cassert>
+#include <iostream>
+#ifndef MOCK_NOSTL
+#include <atomic>
+#include <thread>
+using Udp = OscAsyncUdpTransport<AsyncUDP, AsyncUDPPacket>;  // OscAsyncUDP on ESP32
+using M = ArduinoOSC::Manager<Udp>;
+
+int main() {
+    auto& osc = M::getInstance();
+    auto& server = osc.getServer(50300);
+    auto udp = OscUdpMapManager<Udp>::getInstance().getUdp(50300);
+
+    // loopback through the ring in the same thread
+    int value = 0;
+    osc.subscribe(50300, "/a", value);
+    assert(osc.send("127.0.0.1", 50300, "/a", 123));
+    assert(server.parse());
+    assert(value == 123);
+    assert(!server.parse());
+    assert(!osc.send("not.an.ip", 50300, "/a", 1));
+
+    // the datagram is parsed in the slot of the ring, not copied into the receive buffer of the servers
+    const uint8_t* in_slot = nullptr;
+    osc.subscribe(50300, "/v", [&](const OscMessageView& v) { in_slot = (const uint8_t*)v.address(); });
+    server.useMessageView(true);
+    assert(osc.send("127.0.0.1", 50300, "/v") && server.parse());
+    assert(in_slot && in_slot == udp->packetData());
+    assert(!server.parse());  // the slot is released at the next parsePacket()
+    server.useMessageView(false);
+
+    // datagrams are dropped while the ring is full
+    for (int i = 0; i < 6; ++i) osc.send("127.0.0.1", 50300, "/a", i);
+    assert(udp->pending() == 4 && udp->dropped() == 2);
+    while (server.parse());
+    assert(value == 3);
+
+    // network thread produces while the loop thread consumes
+    static std::atomic<int> notified {0};
+    udp->onReceive([](void*) { ++notified; });
+    const int total = 20000;
+    int received = 0, last = -1;
+    bool in_order = true;
+    osc.subscribe(50300, "/seq", [&](int seq, const String& s) {
+        in_order = in_order && (seq > last) && (s == "payload");
+        last = seq;
+        ++received;
+    });
+    const uint32_t dropped_before = udp->dropped();
+    std::atomic<bool> done {false};
+    std::thread producer([&]() {
+        OscEncoder enc;
+        for (int i = 0; i < total; ++i) {
+            OscMessage m("/seq");
+            m.push(i).push("payload");
+            enc.init().encode(m);
+            AsyncUDP::mock_async_deliver((const uint8_t*)enc.data(), enc.size(), IPAddress(10, 0, 0, 2), 9000, 50300);
+            if ((i & 15) == 0) std::this_thread::yield();
+        }
+        done = true;
+    });
+    while (!done || udp->pending()) server.parse();
+    producer.join();
+    while (server.parse());
+
+    assert(in_order);
+    assert(received == notified);
+    assert(received + (int)(udp->dropped() - dropped_before) == total);
+    assert(received > 0);
+
+    std::cout << "OK\n";
+}
+#else
+int main() {
+    std::cout << "OK\n";  // AsyncUdpTransport needs STL
+}
+#endif
@@ -0,0 +1,36 @@
+// subscribe / send / bundle / publish round trip over the mock udp
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+int main() {
+    auto& osc = M::getInstance();
+    int gi = 0; float gf = 0; String gs;
+    osc.subscribe(50000, "/a/b", gi, gf, gs);
+    int hits = 0;
+    osc.subscribe(50000, "/w/*", [&](const OscMessage& m) { ++hits; });
+    osc.subscribe(50000, "/f", [&](int i, float f) { gi = i; gf = f; });
+    osc.send("127.0.0.1", 50000, "/a/b", 5, 1.5f, String("hey"));
+    osc.send("127.0.0.1", 50000, "/w/x", 1);
+    osc.send("127.0.0.1", 50000, "/w/y", 1);
+    for (int i = 0; i < 5; ++i) osc.parse();
+    assert(gi == 5 && gf == 1.5f && gs == "hey");
+    assert(hits == 2);
+    osc.send("127.0.0.1", 50000, "/f", 7, 2.5f);
+    osc.parse();
+    assert(gi == 7 && gf == 2.5f);
+    osc.begin_bundle(OscTimeTag(1));
+    osc.add_bundle("/w/z", 1);
+    osc.add_bundle("/f", 9, 3.5f);
+    osc.end_bundle();
+    osc.send_bundle("127.0.0.1", 50000);
+    osc.parse();
+    assert(gi == 9 && hits == 3);
+    int pv = 42;
+    osc.publish("127.0.0.1", 50000, "/f", pv, 1.0f)->setIntervalUsec(0);
+    osc.post();
+    osc.parse();
+    assert(gi == 42);
+    std::cout << "OK\n";
+}
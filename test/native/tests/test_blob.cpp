@@ -0,0 +1,77 @@
+// chunked blob transfer: reassembly into the user buffer and the missing-chunk report
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <cstring>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+int main() {
+    auto& osc = M::getInstance();
+    auto& server = osc.getServer(50180);
+
+    static uint8_t frame[3000], rx[3000];
+    for (size_t i = 0; i < sizeof(frame); ++i) frame[i] = (uint8_t)(i * 7 + 3);
+
+    size_t completed = 0, completed_size = 0;
+    OscBlobReassembler r(rx, sizeof(rx), [&](const uint8_t* data, const size_t size) {
+        ++completed;
+        completed_size = size;
+        assert(data == rx);
+    });
+    osc.subscribeBlob(50180, "/frame", r);
+
+    // all chunks in one go
+    OscBlobChunker chunker("/frame");
+    assert(chunker.begin(frame, sizeof(frame)));
+    const size_t n = chunker.numChunks();
+    assert(n == (sizeof(frame) + ARDUINOOSC_BLOB_CHUNK_SIZE - 1) / ARDUINOOSC_BLOB_CHUNK_SIZE);
+    assert(osc.sendBlob("127.0.0.1", 50180, chunker));
+    assert(server.drain(0) == n);
+    assert(completed == 1 && completed_size == sizeof(frame) && r.isComplete());
+    assert(memcmp(frame, rx, sizeof(frame)) == 0);
+    assert(r.transferId() == chunker.transferId() && r.missing(nullptr, 0) == 0);
+
+    // lost chunks are reported and resent, in MessageView mode
+    server.useMessageView(true);
+    for (size_t i = 0; i < sizeof(frame); ++i) frame[i] = (uint8_t)(i * 5 + 1);
+    memset(rx, 0, sizeof(rx));
+    assert(chunker.begin(frame, sizeof(frame)));
+    auto& client = osc.getClient();
+    for (size_t i = 0; i < n; ++i)
+        if ((i != 0) && (i != n - 1)) assert(client.sendBlobChunk("127.0.0.1", 50180, chunker, i));
+    server.drain(0);
+    assert(!r.isComplete() && r.transferId() == chunker.transferId() && completed == 1);
+    uint16_t lost[4];
+    assert(r.missing(lost, 4) == 2 && r.numMissing() == 2 && lost[0] == 0 && lost[1] == n - 1);
+    for (size_t i = 0; i < 2; ++i) assert(client.sendBlobChunk("127.0.0.1", 50180, chunker, lost[i]));
+    client.sendBlobChunk("127.0.0.1", 50180, chunker, lost[0]);  // duplicated
+    server.drain(0);
+    assert(completed == 2 && r.isComplete() && memcmp(frame, rx, sizeof(frame)) == 0);
+    assert(!client.sendBlobChunk("127.0.0.1", 50180, chunker, n));
+    server.useMessageView(false);
+
+    // short and empty blobs
+    const char hello[] = "hello";
+    assert(chunker.begin(hello, 5) && chunker.numChunks() == 1);
+    assert(osc.sendBlob("127.0.0.1", 50180, chunker));
+    server.parse();
+    assert(completed == 3 && completed_size == 5 && memcmp(rx, "hello", 5) == 0);
+    assert(chunker.begin(nullptr, 0) && osc.sendBlob("127.0.0.1", 50180, chunker));
+    server.parse();
+    assert(completed == 4 && completed_size == 0);
+
+    // chunks which do not fit are rejected
+    static uint8_t small[16];
+    OscBlobReassembler rs(small, sizeof(small));
+    osc.subscribeBlob(50180, "/small", rs);
+    OscBlobChunker to_small("/small");
+    assert(to_small.begin(frame, 32));
+    osc.sendBlob("127.0.0.1", 50180, to_small);
+    server.drain(0);
+    assert(!rs.isBegan() && rs.rejected() == 1);
+    osc.send("127.0.0.1", 50180, "/small", 1, 2);
+    server.parse();
+    assert(rs.rejected() == 2);
+    assert(!to_small.begin(frame, ARDUINOOSC_BLOB_CHUNK_SIZE * ARDUINOOSC_BLOB_MAX_CHUNKS + 1));
+    std::cout << "OK\n";
+}
@@ -0,0 +1,31 @@
+// bundle nesting limit, and the former ARDUINOOSC_MAX_MSG_BUNDLE_SIZE still sets it
+#define ARDUINOOSC_MAX_MSG_BUNDLE_SIZE 5
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <cstring>
+#include <iostream>
+int main() {
+    static_assert(ARDUINOOSC_MAX_MSG_BUNDLE_DEPTH == 5, "former macro is honoured");
+    OscMessage m("/deep");
+    m.pushInt32(7);
+
+    // nested up to the limit is encoded and decoded
+    OscEncoder e;
+    for (int i = 0; i < 5; ++i) e.begin_bundle(OscTimeTag(i + 1));
+    e.encode(m);
+    for (int i = 0; i < 5; ++i) e.end_bundle();
+    assert(!e.overflow());
+    OscViewDecoder v(e.data(), e.size());
+    const OscMessageView* r = v.decode();
+    assert(r && strcmp(r->address(), "/deep") == 0 && r->getArgAsInt32(0) == 7 && r->timeTag() == OscTimeTag(5));
+    OscDecoder d(e.data(), e.size());
+    const OscMessage* rm = d.decode();
+    assert(rm && rm->available() && rm->getArgAsInt32(0) == 7);
+
+    // one more level is rejected
+    e.init();
+    for (int i = 0; i < 6; ++i) e.begin_bundle();
+    assert(e.overflow());
+    std::cout << "OK\n";
+}
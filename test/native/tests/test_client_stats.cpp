@@ -0,0 +1,51 @@
+// send results and per-destination statistics (ARDUINOOSC_ENABLE_STATS)
+#define ARDUINOOSC_ENABLE_STATS
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+int main() {
+    auto& osc = M::getInstance();
+    int v = 1;
+    osc.publish("127.0.0.1", 50170, "/a", v)->setIntervalUsec(1000);
+    osc.post();
+    auto* st = osc.getPublishStats("127.0.0.1", 50170, "/a");
+    assert(st && st->attempts == 1 && st->bytes > 0 && st->failures() == 0);
+    assert(osc.getPublishStats("127.0.0.1", 50170, "/none") == nullptr);
+    // failed end
+    MockUdp::fail_end() = 1;
+    mock_micros_offset(1000);
+    osc.post();
+    assert(st->attempts == 2 && st->end_failures == 1);
+    MockUdp::fail_begin() = 1;
+    mock_micros_offset(1000);
+    osc.post();
+    assert(st->attempts == 3 && st->begin_failures == 1);
+    // late post: 4 ticks are missed
+    mock_micros_offset(5500);
+    osc.post();
+    assert(st->attempts == 4 && st->missed_ticks == 4);
+    assert(st->rate() > 0.f);
+    // direct send result
+    MockUdp::fail_end() = 1;
+    assert(!osc.send("127.0.0.1", 50171, "/x", 1));
+    assert(osc.getClient().lastResult() == OscClient<MockUdp>::TX_END_FAILED);
+    assert(osc.send("127.0.0.1", 50171, "/x", 1));
+#ifndef ARDUINOOSC_DISABLE_BUNDLE
+    osc.resetPublishStats();
+    assert(st->attempts == 0);
+    int w = 2;
+    osc.publish("127.0.0.1", 50170, "/b", w)->setIntervalUsec(1000);
+    osc.usePublishBatching(true);
+    mock_micros_offset(1000);
+    osc.post();
+    auto* st2 = osc.getPublishStats("127.0.0.1", 50170, "/b");
+    assert(st->attempts == 1 && st2->attempts == 1 && st2->bytes > 0);
+    MockUdp::fail_end() = 1;
+    mock_micros_offset(1000);
+    osc.post();
+    assert(st->end_failures == 1 && st2->end_failures == 1);
+#endif
+    std::cout << "OK\n";
+}
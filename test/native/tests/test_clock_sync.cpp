@@ -0,0 +1,75 @@
+// clock synchronization by ping-pong
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+int main() {
+    assert((OscTimeTag::fromUnixTime(0).value() >> 32) == 2208988800ULL);
+    assert((uint32_t)OscTimeTag::fromUnixTime(1, 500000).value() == 0x80000000UL);
+    assert(OscTimeTag::now().value() == OscTimeTag::immediate().value());
+    auto& osc = M::getInstance();
+    osc.serveClockSync(50060);
+    assert(OscClock.isSet());
+    osc.beginClockSync("127.0.0.1", 50060, 50061, 10);
+    for (int i = 0; i < 5; ++i) { osc.update(); delay(1); }
+    auto& sync = OscClockSync<MockUdp>::getInstance();
+    assert(sync.isSynced() && sync.samples() >= 1);
+    // master 3 ms ahead -> slewed, not stepped
+    uint64_t before = OscClock.now().value();
+    uint32_t before_us = micros();
+    sync.onPong(micros() - 100, OscClock.now().value() + OscClockManager::usToNtp(3000));
+    assert(sync.offset() > 2500 && sync.offset() < 3100);
+    int64_t moved = OscClockManager::ntpToUs((int64_t)(OscClock.now().value() - before));
+    assert(moved < 1500 && OscClock.isSlewing());
+    assert(OscClock.drift() != 0);
+    mock_micros_offset(100000);
+    assert(!OscClock.isSlewing());
+    moved = OscClockManager::ntpToUs((int64_t)(OscClock.now().value() - before)) - (int64_t)(micros() - before_us);
+    assert(moved > 2500 && moved < 3500);
+    // master 3 ms behind -> the clock slows down but never goes backwards
+    sync.onPong(micros() - 100, OscClock.now().value() - OscClockManager::usToNtp(3000));
+    assert(sync.offset() < -2500 && OscClock.isSlewing());
+    before = OscClock.now().value();
+    before_us = micros();
+    uint64_t prev = before;
+    for (int i = 0; i < 2000; ++i) {
+        if (i % 100 == 0) mock_micros_offset(1000);
+        const uint64_t t = OscClock.now().value();
+        assert(t >= prev);
+        prev = t;
+    }
+    mock_micros_offset(100000);
+    assert(!OscClock.isSlewing());
+    moved = OscClockManager::ntpToUs((int64_t)(OscClock.now().value() - before)) - (int64_t)(micros() - before_us);
+    assert(moved < -2500 && moved > -3500);
+    // direct slew is limited to 10 % of the elapsed time
+    OscClock.setDrift(0);
+    before = OscClock.now().value();
+    before_us = micros();
+    OscClock.slew(-50000, 0);
+    mock_micros_offset(100000);
+    moved = OscClockManager::ntpToUs((int64_t)(OscClock.now().value() - before));
+    assert(moved > 89000 && OscClock.slewRemaining() < 0);
+    // master 1 s ahead -> step
+    sync.onPong(micros() - 100, OscClock.now().value() + OscClockManager::usToNtp(1000000));
+    assert(sync.offset() > 900000);
+    // slow sample is rejected
+    uint32_t rej = sync.rejected();
+    sync.onPong(micros() - 50000, OscClock.now().value());
+    assert(sync.rejected() == rej + 1);
+    osc.endClockSync();
+    // serving and beginning again do not subscribe the handlers twice
+    const size_t pings = osc.getServer(50060).getDispatcher().size();
+    const size_t pongs = osc.getServer(50061).getDispatcher().size();
+    const unsigned errors = mock_log_errors();
+    osc.serveClockSync(50060);
+    osc.beginClockSync("127.0.0.1", 50060, 50061, 10);
+    assert(osc.getServer(50060).getDispatcher().size() == pings && osc.getServer(50061).getDispatcher().size() == pongs);
+    assert(mock_log_errors() == errors);  // not refused as the duplicated subscription
+    osc.getServer(50060).parse();
+    osc.getServer(50061).parse();
+    assert(sync.isSynced());
+    osc.endClockSync();
+    std::cout << "OK\n";
+}
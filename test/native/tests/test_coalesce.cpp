@@ -0,0 +1,78 @@
+// coalescing subscriptions get only the newest message of each parse() pass or time window
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+int main() {
+    auto& osc = M::getInstance();
+    auto& server = osc.getServer(50170);
+    int fader = 0, fader_calls = 0, other_calls = 0;
+    osc.subscribe(50170, "/fader/3", [&](int v) { fader = v; ++fader_calls; });
+    osc.subscribe(50170, "/other", [&](int) { ++other_calls; });
+    assert(!server.coalesce("/not/subscribed"));
+    assert(server.coalesce("/fader/3"));
+
+    // all the messages read by one drain() are collapsed into the last one
+    for (int i = 1; i <= 5; ++i) osc.send("127.0.0.1", 50170, "/fader/3", i);
+    for (int i = 0; i < 3; ++i) osc.send("127.0.0.1", 50170, "/other", i);
+    assert(server.drain(0) == 8);
+    assert(fader == 5 && fader_calls == 1 && other_calls == 3);
+    assert(server.coalesced() == 4);
+
+    // parse() reads one packet, so every packet is dispatched
+    for (int i = 6; i <= 7; ++i) osc.send("127.0.0.1", 50170, "/fader/3", i);
+    server.parse();
+    assert(fader == 6 && fader_calls == 2);
+    server.parse();
+    assert(fader == 7 && fader_calls == 3 && server.coalesced() == 4);
+
+    // messages in one bundle are collapsed by parse()
+    osc.begin_bundle(OscTimeTag::immediate());
+    osc.add_bundle("/fader/3", 8);
+    osc.add_bundle("/fader/3", 9);
+    osc.add_bundle("/other", 0);
+    osc.end_bundle();
+    osc.send_bundle("127.0.0.1", 50170);
+    server.parse();
+    assert(fader == 9 && fader_calls == 4 && other_calls == 4 && server.coalesced() == 5);
+
+    // the held bytes are copied in MessageView mode
+    server.useMessageView(true);
+    for (int i = 10; i <= 13; ++i) osc.send("127.0.0.1", 50170, "/fader/3", i);
+    assert(server.drain(0) == 4);
+    assert(fader == 13 && fader_calls == 5 && server.coalesced() == 8);
+    server.useMessageView(false);
+
+    // whole parse budget of the manager is one pass
+    osc.setParseBudget(0);
+    for (int i = 14; i <= 16; ++i) osc.send("127.0.0.1", 50170, "/fader/3", i);
+    osc.parse();
+    assert(fader == 16 && fader_calls == 6 && server.coalesced() == 10);
+    osc.resetParseBudget();
+
+#ifndef MOCK_NOSTL
+    // newest message is held until the window is over
+    int window = 0, window_calls = 0;
+    osc.subscribe(50170, "/window", [&](int v) { window = v; ++window_calls; });
+    assert(server.coalesce("/window", 50000));
+    osc.send("127.0.0.1", 50170, "/window", 1);
+    server.parse();
+    osc.send("127.0.0.1", 50170, "/window", 2);
+    server.parse();
+    assert(window_calls == 0);
+    mock_micros_offset(60000);
+    server.parse();
+    assert(window == 2 && window_calls == 1);
+    osc.send("127.0.0.1", 50170, "/window", 3);
+    server.parse();
+    assert(window_calls == 1 && server.dispatchCoalesced(true) == 1);
+    assert(window == 3 && window_calls == 2);
+    assert(server.getCoalescer().getSlots()[1].coalesced == 1);
+#else
+    // no more slot than ARDUINOOSC_MAX_COALESCE_PER_PORT
+    osc.subscribe(50170, "/window", [&](int) {});
+    assert(!server.coalesce("/window", 50000));
+#endif
+    std::cout << "OK\n";
+}
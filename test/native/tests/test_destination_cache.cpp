@@ -0,0 +1,29 @@
+// cached ip address and encoded header of publish destinations
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+int main() {
+    auto& osc = M::getInstance();
+    int i = 5; bool b = true; String str = "abc";
+    int gi = 0; bool gb = false; String gs;
+    osc.subscribe(50090, "/v", gi, gb, gs);
+    osc.publish("127.0.0.1", 50090, "/v", i, b, str)->setIntervalUsec(0);
+    osc.setParseBudget(0);
+    osc.post(); osc.parse();
+    assert(gi == 5 && gb && gs == "abc");
+    i = 6; b = false; str = "longer string";  // type tags change (T -> F)
+    delay(1); osc.post(); osc.parse();
+    assert(gi == 6 && !gb && gs == "longer string");
+    // encoded bytes equal to the normal encoder
+    OscMessage m("/v"); m.pushInt32(6).pushBool(false).pushString(str);
+    OscEncoder e; e.encode(m);
+    delay(1); osc.post();
+    auto& q = mock_net()[50090];
+    assert(q.size() == 1 && q.front().data.size() == e.size() && memcmp(q.front().data.data(), e.data(), e.size()) == 0);
+    osc.parse();
+    arduino::osc::client::Destination d("127.0.0.1", 1, "/a"), d2("host.local", 1, "/a");
+    assert(d.resolve() && d.ip_addr[0] == 127 && !d2.resolve());
+    std::cout << "OK\n";
+}
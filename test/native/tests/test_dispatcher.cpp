@@ -0,0 +1,36 @@
+// hashed exact-match dispatch and wildcard patterns
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+int main() {
+    auto& osc = M::getInstance();
+#ifndef MOCK_NOSTL
+    const int n = 64;
+#else
+    const int n = ARDUINOOSC_MAX_SUBSCRIBE_ADDRESS_PER_PORT - 3;  // and three patterns
+#endif
+    int v[64] = {0};
+    for (int i = 0; i < n; ++i) osc.subscribe(50010, String("/ch/") + String(i) + "/fader", v[i]);
+    int star = 0, sup = 0, br = 0;
+    osc.subscribe(50010, "/ch/*/mute", [&](int) { ++star; });
+    osc.subscribe(50010, "//fader", [&](int) { ++sup; });
+    osc.subscribe(50010, "/ch/{0,2}/fader", [&](int) { ++br; });
+    for (int i = 0; i < n; ++i) osc.send("127.0.0.1", 50010, String("/ch/") + String(i) + "/fader", i * 10);
+    osc.send("127.0.0.1", 50010, "/ch/5/mute", 1);
+    osc.send("127.0.0.1", 50010, "/ch/5/nothing", 1);
+    for (int i = 0; i < n + 6; ++i) osc.parse();
+    for (int i = 0; i < n; ++i) assert(v[i] == i * 10);
+    assert(star == 1 && sup == n && br == ((n > 2) ? 2 : 1));
+
+    // the same address and the subscriptions over the capacity are refused
+    const auto& d = osc.getServer(50010).getDispatcher();
+    osc.subscribe(50010, "/ch/0/fader", v[1]);
+    assert(d.size() == (size_t)n + 3);
+#ifdef MOCK_NOSTL
+    osc.subscribe(50010, "/ch/full/fader", v[1]);
+    assert(d.size() == ARDUINOOSC_MAX_SUBSCRIBE_ADDRESS_PER_PORT && v[1] == 0);
+#endif
+    std::cout << "OK\n";
+}
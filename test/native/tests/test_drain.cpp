@@ -0,0 +1,45 @@
+// parse budget and Server::drain()
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+int main() {
+    auto& osc = M::getInstance();
+    int a = 0, b = 0;
+    osc.subscribe(50020, "/a", [&]() { ++a; });
+    osc.subscribe(50021, "/b", [&]() { ++b; });
+    for (int i = 0; i < 40; ++i) osc.send("127.0.0.1", 50020, "/a");
+    for (int i = 0; i < 5; ++i) osc.send("127.0.0.1", 50021, "/b");
+    osc.parse();
+    assert(a == 1 && b == 1);
+    osc.setParseBudget(10);
+    osc.parse();
+    assert(a == 7 && b == 5);
+    osc.parse();
+    assert(a == 17 && b == 5);
+    osc.setParseBudget(0);
+    osc.parse();
+    assert(a == 40 && b == 5);
+    osc.resetParseBudget();
+    for (int i = 0; i < 3; ++i) osc.send("127.0.0.1", 50021, "/b");
+    assert(osc.getServer(50021).drain(0) == 3 && b == 8);
+
+    // a bundle is one packet of the budget however many messages it has
+    // (NO-STL boards dispatch up to the size of the message queue)
+    OscEncoder enc;
+    enc.init().begin_bundle();
+    OscMessage m("/b");
+    for (int i = 0; i < 6; ++i) enc.encode(m);
+    enc.end_bundle();
+    mock_net()[50021].push_back({std::vector<uint8_t>(enc.data(), enc.data() + enc.size()), IPAddress(127, 0, 0, 1), 50021});
+    osc.send("127.0.0.1", 50021, "/b");
+#ifndef MOCK_NOSTL
+    const int in_bundle = 6;
+#else
+    const int in_bundle = ARDUINOOSC_MAX_MSG_QUEUE_SIZE;
+#endif
+    assert(osc.getServer(50021).drain(1) == 1 && b == 8 + in_bundle);
+    assert(osc.getServer(50021).drain(0) == 1 && b == 9 + in_bundle);
+    std::cout << "OK\n";
+}
@@ -0,0 +1,43 @@
+// element arena, RefPtr and reuse of decoded messages
+#define ARDUINOOSC_ELEMENT_ARENA_SIZE 1024
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+int main() {
+    auto& osc = M::getInstance();
+    auto& arena = OscElementArena::getInstance();
+    assert(arena.size() == 0 && arena.capacity() == 1024);
+    int gi = 0;
+    osc.subscribe(50130, "/a", gi);
+    size_t a1 = arena.size();
+    assert(a1 > 0);
+    int hits = 0;
+    osc.subscribe(50130, "/b", [&](const OscMessage&) { ++hits; });
+    assert(arena.size() > a1);
+    auto pub = osc.publish("127.0.0.1", 50130, "/a", gi);
+    assert(pub.use_count() >= 2);
+    { auto p2 = pub; assert(p2.use_count() == pub.use_count()); }
+    // decoder slot reuse
+    OscEncoder enc;
+    enc.begin_bundle(OscTimeTag(1));
+    for (int i = 0; i < 3; ++i) { OscMessage m("/x"); m.push(i); enc.encode(m); }
+    enc.end_bundle();
+    arduino::osc::message::Decoder dec;
+    for (int round = 0; round < 3; ++round) {
+        assert(dec.init(enc.data(), enc.size()));
+        for (int i = 0; i < 3; ++i) { auto* m = dec.decode(); assert(m && m->getArgAsInt32(0) == i && m->address() == "/x"); }
+        assert(dec.decode() == nullptr);
+        OscMessage s("/yy"); s.push(round);
+        OscEncoder e2; e2.encode(s);
+        assert(dec.init(e2.data(), e2.size()));
+        auto* m = dec.decode(); assert(m && m->address() == "/yy" && m->getArgAsInt32(0) == round && m->size() == 1);
+        assert(dec.decode() == nullptr);
+    }
+    osc.send("127.0.0.1", 50130, "/a", 11);
+    osc.send("127.0.0.1", 50130, "/b", 1);
+    osc.parse(); osc.parse();
+    assert(gi == 11 && hits == 1);
+    std::cout << "OK\n";
+}
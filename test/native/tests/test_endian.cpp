@@ -0,0 +1,24 @@
+// byte order conversion of bytes2pod / pod2bytes
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using namespace arduino::osc;
+int main() {
+    char buf[20] = {0};
+    pod2bytes<uint32_t>(0x11223344, buf + 1);
+    assert(buf[1] == 0x11 && buf[4] == 0x44);
+    assert(bytes2pod<uint32_t>(buf + 1) == 0x11223344);
+    pod2bytes<int64_t>(-2, buf + 3);
+    assert((uint8_t)buf[3] == 0xFF && (uint8_t)buf[10] == 0xFE && bytes2pod<int64_t>(buf + 3) == -2);
+    pod2bytes<float>(1.0f, buf);
+    assert((uint8_t)buf[0] == 0x3F && (uint8_t)buf[1] == 0x80);
+    assert(bytes2pod<double>((pod2bytes<double>(0.1, buf + 5), buf + 5)) == 0.1);
+    float in[64], out[64]; char raw[64 * 4 + 1];
+    for (int i = 0; i < 64; ++i) in[i] = i * 0.5f;
+    pods2bytes(in, raw + 1, 64);
+    bytes2pods(raw + 1, out, 64);
+    for (int i = 0; i < 64; ++i) assert(out[i] == in[i] && bytes2pod<float>(raw + 1 + 4 * i) == in[i]);
+    assert(!isBigEndian());
+    std::cout << "OK\n";
+}
@@ -0,0 +1,89 @@
+// extended type tags t c m r N I [ ] and the bulk float array accessor
+#define ARDUINOOSC_MAX_MSG_ARGUMENT_SIZE 16  // 13 arguments on NO-STL boards
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <cstring>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+using namespace arduino::osc;
+
+template <typename Msg>
+void check(const Msg& m) {
+    assert(m.size() == 13);
+    assert(m.isArrayBegin(0) && m.isArrayEnd(5) && m.isTimeTag(6) && m.isChar(7) && m.isMidi(8));
+    assert(m.isRgba(9) && m.isNil(10) && m.isImpulse(11) && m.isInt32(12));
+    float f[4] = {0, 0, 0, 0};
+    assert(m.getArgsAsFloatArray(1, 4, f));
+    for (size_t i = 0; i < 4; ++i) assert(f[i] == m.getArgAsFloat(1 + i) && f[i] == 0.5f * (float)i - 1.f);
+    assert(m.getArgsAsFloatArray(2, 2, f) && f[0] == -0.5f && f[1] == 0.f);
+    assert(m.getArgsAsFloatArray(1, 0, f));
+    assert(!m.getArgsAsFloatArray(0, 4, f) && !m.getArgsAsFloatArray(1, 5, f) && !m.getArgsAsFloatArray(12, 2, f));
+    assert(m.getArgAsTimeTag(6) == OscTimeTag(0x0123456789ABCDEFULL) && m.template arg<OscTimeTag>(6).value() == 0x0123456789ABCDEFULL);
+    assert(m.getArgAsChar(7) == 'x' && m.getArgAsMidi(8) == 0x00903C7FUL && m.getArgAsRgba(9) == 0xFF8000FFUL);
+    assert(m.getArgAsInt32(12) == 42);
+}
+
+int main() {
+    // raw packet as sent by other implementations
+    char raw[64];
+    memset(raw, 0, sizeof(raw));
+    memcpy(raw, "/arr", 4);
+    memcpy(raw + 8, ",[ffff]tcmrNIi", 14);
+    char* p = raw + 24;
+    for (int i = 0; i < 4; ++i, p += 4) pod2bytes<float>(0.5f * (float)i - 1.f, p);
+    pod2bytes<uint64_t>(0x0123456789ABCDEFULL, p), p += 8;
+    pod2bytes<int32_t>('x', p), p += 4;
+    pod2bytes<uint32_t>(0x00903C7FUL, p), p += 4;
+    pod2bytes<uint32_t>(0xFF8000FFUL, p), p += 4;
+    pod2bytes<int32_t>(42, p), p += 4;
+    assert(p == raw + sizeof(raw));
+
+    OscMessage m(raw, sizeof(raw));
+    assert(m.available());
+    check(m);
+    OscMessageView v(raw, sizeof(raw));
+    assert(v.available());
+    check(v);
+    float back[4];
+    assert(v.getArgAsInt32(12) == 42 && v.getArgsAsFloatArray(1, 4, back) && back[3] == 0.5f);  // cursor moved back
+
+    // same message built by push
+    const float fs[4] = {-1.f, -0.5f, 0.f, 0.5f};
+    OscMessage b("/arr");
+    b.pushFloatArray(fs, 4).push(OscTimeTag(0x0123456789ABCDEFULL)).pushChar('x').pushMidi(0x00903C7FUL);
+    b.pushRgba(0xFF8000FFUL).pushNil().pushImpulse().push(42);
+    check(b);
+    OscEncoder enc;
+    enc.init().encode(b);
+    assert(enc.size() == sizeof(raw) && memcmp(enc.data(), raw, sizeof(raw)) == 0);
+
+    // unknown tags are still rejected
+    raw[9] = 'Z';
+    assert(!OscMessage(raw, sizeof(raw)).available() && !OscMessageView(raw, sizeof(raw)).available());
+    raw[9] = '[';
+
+#ifdef MOCK_NOSTL
+    // more arguments than the NO-STL argument list are rejected
+    char nils[32];
+    memset(nils, 0, sizeof(nils));
+    memcpy(nils, "/nil", 4);
+    memcpy(nils + 8, ",NNNNNNNNNNNNNNNNN", 18);
+    assert(!OscMessage(nils, sizeof(nils)).available());
+    nils[8 + 17] = 0;
+    assert(OscMessage(nils, 28).available() && OscMessage(nils, 28).size() == 16);
+#endif
+
+    // received by the server in both modes
+    auto& osc = M::getInstance();
+    auto& server = osc.getServer(50190);
+    size_t hits = 0;
+    osc.subscribe(50190, "/arr", [&](const OscMessage& r) { check(r); ++hits; });
+    osc.getClient().send("127.0.0.1", 50190, b);
+    server.parse();
+    server.useMessageView(true);
+    osc.getClient().send("127.0.0.1", 50190, b);
+    server.parse();
+    assert(hits == 2);
+    std::cout << "OK\n";
+}
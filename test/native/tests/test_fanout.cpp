@@ -0,0 +1,83 @@
+// fan-out groups: one encode sent to the multicast group and the unicast hosts, with the cached interface
+#include <MockUdp.h>
+static IPAddress& link_ip() { static IPAddress ip; return ip; }
+#define ARDUINOOSC_DEFAULT_MULTICAST_IFACE() link_ip()
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+
+int main() {
+    auto& osc = M::getInstance();
+    auto& client = osc.getClient();
+
+    OscFanout group;
+    assert(group.addMulticast("239.0.0.1", 50200));
+    assert(group.add("127.0.0.1", 50201) && group.add("127.0.0.2", 50202));
+    assert(!group.add("monitor.local", 50203) && group.size() == 3);
+    assert(group.add("127.0.0.2", 50202) && group.size() == 3);  // duplicated
+    assert(group.getEndpoints()[0].is_multicast && !group.getEndpoints()[1].is_multicast);
+
+    // every endpoint gets the same packet
+    assert(osc.send(group, "/state", 1, 2.5f));
+    assert(mock_pending(50200) == 1 && mock_pending(50201) == 1 && mock_pending(50202) == 1);
+    const MockDatagram d = mock_pop(50200);
+    assert(mock_pop(50201).data == d.data && mock_pop(50202).data == d.data);
+    OscMessage m(d.data.data(), d.data.size());
+    assert(m.available() && m.address() == "/state" && m.arg<int>(0) == 1 && m.arg<float>(1) == 2.5f);
+    for (const auto& e : group.getEndpoints()) assert(e.sent == 1 && e.failures == 0);
+
+    // the interface of the client is cached once the link has the address, and the endpoint can override it
+    assert(client.multicastInterface() == IPAddress() && MockUdp::last_iface() == IPAddress());
+    link_ip() = IPAddress(192, 168, 0, 5);
+    assert(client.multicastInterface() == IPAddress(192, 168, 0, 5));
+    link_ip() = IPAddress(192, 168, 0, 6);
+    assert(client.multicastInterface() == IPAddress(192, 168, 0, 5));
+    osc.linkChanged();
+    assert(client.multicastInterface() == IPAddress(192, 168, 0, 6));
+    client.sendMulticast("239.0.0.1", 50200);
+    assert(MockUdp::last_iface() == IPAddress(192, 168, 0, 6));
+    link_ip() = IPAddress();
+    osc.linkChanged();
+    client.multicastInterface(IPAddress(192, 168, 0, 10));
+    osc.send(group, "/state", 2);
+    assert(MockUdp::last_iface() == IPAddress(192, 168, 0, 10));
+    group.multicastInterface(IPAddress(10, 0, 0, 1));
+    osc.send(group, "/state", 3);
+    assert(MockUdp::last_iface() == IPAddress(10, 0, 0, 1));
+    client.sendMulticast("239.0.0.1", 50200);
+    assert(MockUdp::last_iface() == IPAddress(192, 168, 0, 10));
+    client.multicastInterface(IPAddress());
+    for (uint16_t p = 50200; p <= 50202; ++p) mock_net()[p].clear();
+
+    // failure of one endpoint does not stop the others
+    MockUdp::fail_begin() = 1;
+    assert(!osc.send(group, "/state", 4));
+    assert(group.getEndpoints()[1].failures == 1 && mock_pending(50200) == 1 && mock_pending(50201) == 0 && mock_pending(50202) == 1);
+    assert(group.remove("127.0.0.1", 50201) && !group.remove("127.0.0.1", 50201) && group.size() == 2);
+    assert(group.getEndpoints()[1].port == 50202);
+    mock_net()[50200].clear();
+    mock_net()[50202].clear();
+
+    // publisher is encoded once per tick for the whole group
+    int value = 7;
+    auto ref = osc.publish(group, "/value", value);
+    assert(ref && osc.getPublishElementRef(group, "/value") == ref);
+    osc.post();
+    assert(mock_pending(50200) == 1 && mock_pending(50202) == 1 && mock_pop(50200).data == mock_pop(50202).data);
+    assert(group.getEndpoints()[0].sent == 5);
+
+#ifndef ARDUINOOSC_DISABLE_BUNDLE
+    // publishers of the same group are batched in one bundle
+    ref->setIntervalUsec(0);
+    auto ref2 = osc.publish(group, "/pair", 1, 2);
+    ref2->setIntervalUsec(0);
+    osc.usePublishBatching(true);
+    osc.post();
+    assert(mock_pending(50200) == 1 && mock_pending(50202) == 1);
+    const MockDatagram b = mock_pop(50200);
+    assert(b.data.size() > 8 && memcmp(b.data.data(), "#bundle", 8) == 0 && mock_pop(50202).data == b.data);
+    osc.usePublishBatching(false);
+#endif
+    std::cout << "OK\n";
+}
@@ -0,0 +1,58 @@
+// MessageView and ViewDecoder, and the view mode of the server
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+int main() {
+    // view decoding of bundle
+    OscEncoder wr; OscMessage msg;
+    wr.init().begin_bundle(OscTimeTag(77));
+    wr.encode(msg.init("/foo").push(1000).push(-1).push("hello").push(1.234f).push(true).push(5.678f));
+    wr.begin_bundle(OscTimeTag(5)); wr.encode(msg.init("/in").push(3)); wr.end_bundle();
+    uint8_t b[3] = {1,2,3};
+    wr.encode(msg.init("/blob").pushBlob(b, 3).push(2.5));
+    wr.end_bundle();
+    OscViewDecoder vd(wr.data(), wr.size());
+    auto* v = vd.decode();
+    assert(v && v->available() && v->match("/foo") && v->size() == 6);
+    assert(v->timeTag() == 77);
+    assert(v->arg<int>(0) == 1000 && v->arg<int>(1) == -1 && v->arg<String>(2) == "hello");
+    assert(v->arg<float>(3) == 1.234f && v->arg<bool>(4) && v->arg<float>(5) == 5.678f);
+    assert(v->arg<float>(3) == 1.234f && v->arg<int>(0) == 1000);
+    OscMessage cm = v->toMessage();
+    assert(cm.arg<float>(5) == 5.678f && cm.address() == "/foo");
+    v = vd.decode();
+    assert(v && v->match("/in") && v->arg<int>(0) == 3 && v->timeTag() == 5);
+    v = vd.decode();
+    size_t n; auto p = v->getArgAsBlobPtr(0, n);
+    assert(n == 3 && p[2] == 3 && v->arg<double>(1) == 2.5 && v->timeTag() == 77);
+    assert(vd.decode() == nullptr);
+    wr.init().begin_bundle().begin_bundle().end_bundle().end_bundle();
+    assert(vd.init(wr.data(), wr.size()) && vd.decode() == nullptr);
+    // corrupted
+    char bad[8] = "/a\0\0,i\0";
+    assert(vd.init(bad, 8)); v = vd.decode(); assert(v && !v->available());
+
+    auto& osc = M::getInstance();
+    osc.getServer(50001).useMessageView(true);
+    int gi = 0; float gf = 0; String gs; int hits = 0, mh = 0;
+    osc.subscribe(50001, "/a/b", gi, gf, gs);
+    osc.subscribe(50001, "/w/*", [&](const OscMessageView&) { ++hits; });
+    osc.subscribe(50001, "/w/?", [&](const OscMessage& m) { ++mh; assert(m.address().c_str()[1] == 'w'); });
+    osc.subscribe(50001, "/f", [&](int i, float f) { gi = i; gf = f; });
+    osc.send("127.0.0.1", 50001, "/a/b", 5, 1.5f, String("hey"));
+    osc.send("127.0.0.1", 50001, "/w/x", 1);
+    for (int i = 0; i < 3; ++i) osc.parse();
+    assert(gi == 5 && gf == 1.5f && gs == "hey" && hits == 1 && mh == 1);
+    osc.send("127.0.0.1", 50001, "/f", 7, 2.5f);
+    osc.parse();
+    assert(gi == 7 && gf == 2.5f);
+    // view callback on non-view server
+    int vh = 0;
+    osc.subscribe(50002, "/v", [&](const OscMessageView& m) { vh = m.arg<int>(0); });
+    osc.send("127.0.0.1", 50002, "/v", 11);
+    osc.parse();
+    assert(vh == 11);
+    std::cout << "OK\n";
+}
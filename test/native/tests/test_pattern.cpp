@@ -0,0 +1,55 @@
+// compiled patterns give the same full-match results as internalPatternMatch()
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <string>
+using namespace arduino::osc;
+
+static bool reference(const std::string& pattern, const std::string& path) {
+    const char* q = internalPatternMatch(pattern.c_str(), path.c_str());
+    return q && (*q == 0);
+}
+
+static bool compiled(const std::string& pattern, const std::string& path) {
+    pattern::CompiledPattern p;
+    p.compile(pattern.c_str());
+    return p.match(pattern.c_str(), path.c_str(), path.size());
+}
+
+int main() {
+    assert(OscPattern("/a/b").isLiteral());
+    assert(!OscPattern("/a/*").isLiteral());
+    assert(OscPattern("/mixer/*/12/{fader,mute}").match("/mixer/ch/12/mute"));
+    assert(!OscPattern("/mixer/*/12/{fader,mute}").match("/mixer/ch/x/12/mute"));
+    assert(OscPattern("//fader").match("/a/b/fader"));
+    assert(OscPattern("/ch/[0-9]").match("/ch/7"));
+    assert(!OscPattern("/ch/[!0-9]").match("/ch/7"));
+    assert(!OscPattern("/ch/[0-9").match("/ch/7"));
+    assert(!OscPattern("/ch/{a,b").match("/ch/a"));
+
+    OscMessage m("/ch/3/gain");
+    assert(m.match(OscPattern("/ch/?/gain")));
+    assert(!m.match(OscPattern("/ch/?/mute")));
+
+    // random patterns and paths over a small alphabet
+    const char* pattern_parts[] = {"a", "b", "/", "ab", "*", "?", "//", "[a-b]", "[!a]", "{a,ab}", "{b,,a}", "[", "{"};
+    const char* path_parts[] = {"a", "b", "/", "c"};
+    std::mt19937 rng(12345);
+    size_t checked = 0;
+    for (size_t i = 0; i < 200000; ++i) {
+        std::string pattern = "/", path = "/";
+        const size_t np = rng() % 7, nq = rng() % 9;
+        for (size_t j = 0; j < np; ++j) pattern += pattern_parts[rng() % (sizeof(pattern_parts) / sizeof(pattern_parts[0]))];
+        for (size_t j = 0; j < nq; ++j) path += path_parts[rng() % (sizeof(path_parts) / sizeof(path_parts[0]))];
+        const bool expected = reference(pattern, path);
+        if (compiled(pattern, path) != expected) {
+            std::cout << "Failed: " << pattern << " " << path << " expected " << expected << "\n";
+            return 1;
+        }
+        if (expected) ++checked;
+    }
+    assert(checked > 1000);
+    std::cout << "OK\n";
+}
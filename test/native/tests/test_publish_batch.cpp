@@ -0,0 +1,33 @@
+// batching due publishers into per-host bundles
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+int main() {
+    auto& osc = M::getInstance();
+    int got = 0, other = 0;
+    osc.subscribe(50080, "/b/*", [&](const OscMessage&) { ++got; });
+    osc.subscribe(50081, "/o", [&](int) { ++other; });
+    const char* names[] = {"/b/0", "/b/1", "/b/2"};
+    for (auto n : names) osc.publish("127.0.0.1", 50080, n, 123456789, 1.5f, String("some string payload"));
+    osc.publish("127.0.0.1", 50081, "/o", 7);
+    osc.usePublishBatching(true, 120);
+    osc.post();
+    assert(mock_net()[50080].size() == 2);  // 3 messages of ~48 bytes split at 120 bytes
+    assert(mock_net()[50081].size() == 1);
+    osc.setParseBudget(0);
+    osc.parse();
+    assert(got == 3 && other == 1);
+    osc.usePublishBatching(true);
+    delay(40);
+    osc.post();
+#ifndef MOCK_NOSTL
+    assert(mock_net()[50080].size() == 1);
+#else
+    assert(mock_net()[50080].size() == 2);  // clamped to ARDUINOOSC_MAX_MSG_BYTE_SIZE
+#endif
+    osc.parse();
+    assert(got == 6 && other == 2);
+    std::cout << "OK\n";
+}
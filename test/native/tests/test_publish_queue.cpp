@@ -0,0 +1,43 @@
+// publish deadlines across micros() wrap-around
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+int main() {
+    mock_micros_offset(0xFFFFFFFF - 60000 - micros());  // micros() wraps in the first loop
+    auto& osc = M::getInstance();
+    int fast = 0, slow = 0;
+    osc.subscribe(50070, "/fast", [&](int) { ++fast; });
+    osc.subscribe(50070, "/slow", [&](int) { ++slow; });
+    osc.publish("127.0.0.1", 50070, "/fast", 1)->setIntervalMsec(5);
+    osc.publish("127.0.0.1", 50070, "/slow", 2)->setIntervalMsec(40);
+    assert(osc.post() != OscPublishQueue::NO_DEADLINE);
+    osc.setParseBudget(0);
+    osc.parse();
+    assert(fast == 1 && slow == 1);
+    uint32_t wait = osc.post();
+    assert(wait > 0 && wait <= 5000);
+    uint32_t t0 = micros();
+    while (micros() - t0 < 100000) { uint32_t w = osc.post(); delayMicroseconds(w > 1000 ? 1000 : w); osc.parse(); }
+    assert(fast >= 15 && fast <= 22 && slow >= 3 && slow <= 4);
+    osc.getPublishElementRef("127.0.0.1", 50070, "/slow")->setIntervalMsec(5);
+    slow = 0; t0 = micros();
+    while (micros() - t0 < 50000) { osc.post(); delayMicroseconds(500); osc.parse(); }
+    assert(slow >= 8);
+    assert(!osc.getPublishElementRef("127.0.0.1", 50070, "/none"));
+
+#ifdef MOCK_NOSTL
+    // publishers over the capacity are not added to the queue
+    int more = 0;
+    osc.subscribe(50070, "/more", [&](int) { ++more; });
+    for (int i = 0; i < 4; ++i) osc.publish("127.0.0.1", 50070 + i, "/more", i);
+    assert(osc.getPublishElementRef("127.0.0.1", 50070, "/more") && osc.getPublishElementRef("127.0.0.1", 50071, "/more"));
+    assert(ARDUINOOSC_MAX_PUBLISH_DESTINATION == 4 && !osc.getPublishElementRef("127.0.0.1", 50072, "/more"));
+    mock_net()[50070].clear();
+    osc.post();
+    osc.parse();
+    assert(more == 1);
+#endif
+    std::cout << "OK\n";
+}
@@ -0,0 +1,62 @@
+// change-driven and adaptive publishers
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+int main() {
+    auto& osc = M::getInstance();
+    auto& q = mock_net()[50180];
+    int v = 1;
+    auto pub = osc.publish("127.0.0.1", 50180, "/a", v);
+    pub->setIntervalUsec(1000);
+    pub->setChangeDriven(true, 10000);
+    osc.post();
+    assert(q.size() == 1);
+    for (int i = 0; i < 5; ++i) { mock_micros_offset(1000); osc.post(); }
+    assert(q.size() == 1);  // unchanged
+    v = 2;
+    mock_micros_offset(1000); osc.post();
+    assert(q.size() == 2);
+    for (int i = 0; i < 10; ++i) { mock_micros_offset(1000); osc.post(); }
+    assert(q.size() == 3);  // keep-alive
+    // failed send is retried
+    v = 3;
+    MockUdp::fail_end() = 1;
+    mock_micros_offset(1000); osc.post();
+    assert(q.size() == 3);
+    mock_micros_offset(1000); osc.post();
+    assert(q.size() == 4);
+    q.clear();
+    pub->setChangeDriven(false);
+
+    // adaptive
+    pub->setAdaptive(true, 8000);
+    MockUdp::fail_end() = 4;
+    for (int i = 0; i < 4; ++i) { mock_micros_offset(20000); osc.post(); }
+    assert(pub->backoffUsec() == 7000 && pub->currentIntervalUsec() == 8000);
+    uint32_t prev = pub->backoffUsec();
+    for (int i = 0; i < 100; ++i) {
+        mock_micros_offset(pub->currentIntervalUsec());
+        osc.post();
+        assert(pub->backoffUsec() <= prev); prev = pub->backoffUsec();
+    }
+    assert(pub->backoffUsec() == 0);
+#ifndef ARDUINOOSC_DISABLE_BUNDLE
+    auto& q2 = mock_net()[50181];
+    int a = 1, b = 1;
+    auto pa = osc.publish("127.0.0.1", 50181, "/a", a); pa->setIntervalUsec(1000); pa->setChangeDriven(true, 1000000);
+    auto pb = osc.publish("127.0.0.1", 50181, "/b", b); pb->setIntervalUsec(1000); pb->setChangeDriven(true, 1000000);
+    osc.usePublishBatching(true);
+    mock_micros_offset(20000); osc.post();
+    size_t n0 = q2.size();
+    assert(n0 == 1);  // one bundle
+    mock_micros_offset(1000); osc.post();
+    assert(q2.size() == n0);
+    b = 5;
+    mock_micros_offset(1000); osc.post();
+    assert(q2.size() == n0 + 1);
+    osc.usePublishBatching(false);
+#endif
+    std::cout << "OK\n";
+}
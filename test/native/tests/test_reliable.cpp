@@ -0,0 +1,140 @@
+// reliable delivery: envelope with the sequence number, ACK / NACK, retransmission and duplicate rejection
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+
+int main() {
+    auto& osc = M::getInstance();
+    auto& sender = OscReliableLink<MockUdp>::getInstance().getSender();
+    const auto& receiver = osc.getReliable().getReceiver();
+    auto& rx = osc.getServer(50211);
+    auto& ack = osc.getServer(50210);
+
+    osc.beginReliable(50210);
+    const size_t subs = ack.getDispatcher().size();
+    osc.beginReliable(50210);
+    assert(ack.getDispatcher().size() == subs);
+    assert(osc.reliable("/cue") && osc.reliable("/cue"));
+    osc.serveReliable(50211);
+    std::vector<int> cues;
+    int plain = 0;
+    osc.subscribe(50211, "/cue", [&](const OscMessage& m) {
+        assert(m.remoteIP() == "127.0.0.1");
+        cues.push_back(m.arg<int>(0));
+    });
+    osc.subscribe(50211, "/plain", [&](int i) { plain = i; });
+
+    // the message is wrapped in the envelope and held until acknowledged
+    assert(osc.send("127.0.0.1", 50211, "/cue", 1));
+    assert(mock_pending(50211) == 1 && sender.pending() == 1 && sender.sent() == 1);
+    const MockDatagram env = mock_net()[50211].front();
+    OscMessage e(env.data.data(), env.data.size());
+    assert(e.available() && e.address() == "/rel/msg" && e.typeTags() == "iiib" && e.arg<int>(1) == 1 && e.arg<int>(2) == 50210);
+    rx.parse();
+    assert(cues.size() == 1 && cues[0] == 1 && mock_pending(50210) == 1);
+    ack.parse();
+    assert(sender.pending() == 0 && sender.acked() == 1);
+
+    // duplicates are dropped but acknowledged again
+    mock_net()[50211].push_back(env);
+    rx.parse();
+    assert(cues.size() == 1 && receiver.duplicated() == 1 && mock_pending(50210) == 1);
+    ack.parse();
+    assert(sender.acked() == 1);
+
+    // the gap is reported by NACK and resent at the next post()
+    MockUdp::fail_end() = 1;
+    assert(!osc.send("127.0.0.1", 50211, "/cue", 2));
+    assert(osc.send("127.0.0.1", 50211, "/cue", 3));
+    rx.parse();
+    assert(cues.size() == 2 && cues[1] == 3 && receiver.nacked() == 1 && mock_pending(50210) == 2);
+    ack.parse();
+    ack.parse();
+    assert(sender.pending() == 1);
+    osc.post();
+    assert(sender.retransmitted() == 1 && mock_pending(50211) == 1);
+    rx.parse();
+    ack.parse();
+    assert(cues.size() == 3 && cues[2] == 2 && sender.pending() == 0);
+
+    // the lost packet is resent after the timeout
+    MockUdp::fail_end() = 1;
+    osc.send("127.0.0.1", 50211, "/cue", 4);
+    osc.post();
+    assert(mock_pending(50211) == 0 && sender.retransmitted() == 1);
+    mock_micros_offset(ARDUINOOSC_RELIABLE_TIMEOUT_US);
+    osc.post();
+    assert(mock_pending(50211) == 1 && sender.retransmitted() == 2);
+    rx.useMessageView(true);
+    rx.parse();
+    ack.parse();
+    assert(cues.size() == 4 && cues[3] == 4 && sender.pending() == 0);
+
+    // given up after the retries
+    sender.setMaxRetries(1);
+    MockUdp::fail_end() = 2;
+    osc.send("127.0.0.1", 50211, "/cue", 5);
+    mock_micros_offset(ARDUINOOSC_RELIABLE_TIMEOUT_US);
+    osc.post();
+    mock_micros_offset(2 * ARDUINOOSC_RELIABLE_TIMEOUT_US);
+    osc.post();
+    assert(sender.pending() == 0 && sender.givenUp() == 1 && mock_pending(50211) == 0);
+
+    // other addresses are sent as they are, without ACK
+    assert(osc.send("127.0.0.1", 50211, "/plain", 7));
+    const MockDatagram& raw = mock_net()[50211].front();
+    assert(OscMessage(raw.data.data(), raw.data.size()).address() == "/plain");
+    rx.parse();
+    assert(plain == 7 && mock_pending(50210) == 0 && sender.sent() == 5);
+
+    // a new session of the sender starts the sequence again
+    OscReliableReceiver r;
+    size_t replies = 0;
+    r.onReply([&](const IPAddress&, const uint16_t, OscMessage&) { ++replies; });
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    OscMessage inner("/x");
+    inner.push(1);
+    OscEncoder enc;
+    enc.init().encode(inner);
+    OscMessage a;
+    a.init("/rel/msg").pushInt32(10).pushInt32(1).pushInt32(1234).pushBlob(enc.data(), enc.size());
+    assert(r.accept(a, IPAddress(127, 0, 0, 1), 1, data, size) && size == enc.size());
+    assert(!r.accept(a, IPAddress(127, 0, 0, 1), 1, data, size));
+    a.init("/rel/msg").pushInt32(11).pushInt32(1).pushInt32(1234).pushBlob(enc.data(), enc.size());
+    assert(r.accept(a, IPAddress(127, 0, 0, 1), 1, data, size) && replies == 3);
+    a.init("/rel/msg").pushInt32(11).pushInt32(1);
+    assert(!r.accept(a, IPAddress(127, 0, 0, 1), 1, data, size) && r.rejected() == 1);
+
+    // the forgotten destination starts the new session, so its sequence is not taken as old one
+    OscReliableSender s;
+    s.begin(1234);
+    OscMessage e1, e2;
+    assert(s.wrap(e1, IPAddress(127, 0, 0, 1), 1, enc.data(), enc.size()) == 1);
+    assert(s.wrap(e1, IPAddress(127, 0, 0, 1), 1, enc.data(), enc.size()) == 2);
+    assert(r.accept(e1, IPAddress(127, 0, 0, 1), 1, data, size));
+    for (uint16_t p = 2; p <= ARDUINOOSC_RELIABLE_MAX_PEERS + 1; ++p) s.wrap(e2, IPAddress(127, 0, 0, 1), p, enc.data(), enc.size());
+    assert(s.wrap(e2, IPAddress(127, 0, 0, 1), 1, enc.data(), enc.size()) == 1);
+    assert(e2.arg<int>(0) != e1.arg<int>(0));
+    assert(r.accept(e2, IPAddress(127, 0, 0, 1), 1, data, size));
+
+    // the sequences to the other ports of the same receiver are counted separately
+    OscMessage e3;
+    assert(s.wrap(e3, IPAddress(127, 0, 0, 1), 2, enc.data(), enc.size()) == 1);
+    assert(r.accept(e3, IPAddress(127, 0, 0, 1), 2, data, size));
+    assert(!r.accept(e2, IPAddress(127, 0, 0, 1), 1, data, size));
+
+    // the destinations with pending packets are not forgotten
+    OscReliableSender held;
+    held.begin(1234);
+    for (uint16_t p = 1; p <= ARDUINOOSC_RELIABLE_MAX_PEERS; ++p) {
+        const uint32_t seq = held.wrap(e1, IPAddress(127, 0, 0, 1), p, enc.data(), enc.size());
+        held.hold(seq, IPAddress(127, 0, 0, 1), p, enc.data(), enc.size());
+    }
+    assert(held.wrap(e1, IPAddress(127, 0, 0, 1), 100, enc.data(), enc.size()) == 0);
+    held.ack(IPAddress(127, 0, 0, 1), 1, 1);
+    assert(held.wrap(e1, IPAddress(127, 0, 0, 1), 100, enc.data(), enc.size()) == 1);
+    std::cout << "OK\n";
+}
@@ -0,0 +1,26 @@
+// binary remote address of received messages
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+int main() {
+    auto& osc = M::getInstance();
+    int n = 0; bool ok = true;
+    osc.subscribe(50140, "/a", [&](const OscMessage& m) {
+        ++n;
+        ok = ok && m.remoteAddress() == IPAddress(127, 0, 0, 1) && m.remoteIP() == "127.0.0.1";
+    });
+    osc.subscribe(50140, "/v", [&](const OscMessageView& v) { ++n; ok = ok && v.remoteIP() == IPAddress(127, 0, 0, 1); });
+    osc.send("127.0.0.1", 50140, "/a", 1);
+    osc.send("127.0.0.1", 50140, "/v", 1);
+    osc.parse(); osc.parse();
+    assert(n == 2 && ok);
+    OscMessage m("10.0.0.2", 9, "/x");
+    assert(m.remoteAddress() == IPAddress(10, 0, 0, 2) && m.remoteIP() == "10.0.0.2");
+    m.remoteIP(IPAddress(1, 2, 3, 4));
+    assert(m.remoteIP() == "1.2.3.4");
+    OscMessage c = m;
+    assert(c.remoteIP() == "1.2.3.4" && c.remoteAddress() == IPAddress(1, 2, 3, 4));
+    std::cout << "OK\n";
+}
@@ -0,0 +1,47 @@
+// receive buffer shared by the servers and oversized packets
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+
+// "/a" with the string of n bytes, the packet is 8 + (n + 4) / 4 * 4 bytes
+static MockDatagram datagram(const size_t n) {
+    MockDatagram d {{'/', 'a', 0, 0, ',', 's', 0, 0}, IPAddress(127, 0, 0, 1), 50031};
+    d.data.resize(d.data.size() + (n + 4) / 4 * 4, 0);
+    for (size_t i = 0; i < n; ++i) d.data[8 + i] = 'x';
+    return d;
+}
+
+int main() {
+    auto& osc = M::getInstance();
+    int a = 0, b = 0;
+    String last;
+    osc.subscribe(50030, "/a", [&](const String& s) { ++a; last = s; });
+    osc.subscribe(50032, "/a", [&](const String& s) { ++b; });
+
+    // the largest packet fits, one more word is dropped and counted
+    const size_t fits = OscRxBuffer::capacity() - 9;
+    mock_net()[50030].push_back(datagram(fits));
+    mock_net()[50030].push_back(datagram(fits + 4));
+    mock_net()[50030].push_back(datagram(2));
+    bool r = false;
+    auto& server = osc.getServer(50030);
+    assert(server.parse(r) && r && a == 1 && last.length() == fits && server.dropped() == 0);
+    assert(!server.parse(r) && r && a == 1 && server.dropped() == 1);
+    assert(server.parse(r) && a == 2 && last == "xx" && server.dropped() == 1);
+
+    // the buffer is shared, the packets of other ports are read into the same one
+    mock_net()[50032].push_back(datagram(3));
+    assert(osc.getServer(50032).parse(r) && b == 1 && osc.getServer(50032).dropped() == 0);
+    assert(OscRxBuffer::shared().size == datagram(3).data.size());
+
+    // parse() from the callback leaves the packet in the socket instead of overwriting the buffer
+    bool nested = true;
+    osc.subscribe(50030, "/n", [&]() { nested = osc.getServer(50032).parse(); });
+    osc.send("127.0.0.1", 50030, "/n");
+    mock_net()[50032].push_back(datagram(1));
+    assert(server.parse() && !nested && b == 1 && mock_pending(50032) == 1);
+    assert(osc.getServer(50032).parse() && b == 2);
+    std::cout << "OK\n";
+}
@@ -0,0 +1,48 @@
+// deferred dispatch of bundles by time tag
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+#include <vector>
+using M = ArduinoOSC::Manager<MockUdp>;
+int main() {
+    assert(OscClockManager::ntpToUs(OscClockManager::usToNtp(1234567)) - 1234567 <= 1);
+    assert(OscClockManager::ntpToUs(-(int64_t)OscClockManager::usToNtp(20000)) >= -20000 && OscClockManager::ntpToUs(-(int64_t)OscClockManager::usToNtp(20000)) <= -19999);
+    auto& osc = M::getInstance();
+    std::vector<int> got;
+    osc.subscribe(50040, "/cue", [&](int i) { got.push_back(i); });
+    for (int pass = 0; pass < 2; ++pass) {
+        got.clear();
+        osc.getServer(50040).useMessageView(pass == 1);
+        osc.getServer(50040).useScheduler(true);
+        OscClock.set(OscTimeTag(1000ULL << 32));
+        uint64_t now = OscClock.now();
+        OscTimeTag t20(now + OscClockManager::usToNtp(20000)), t10(now + OscClockManager::usToNtp(10000));
+        osc.begin_bundle(t20); osc.add_bundle("/cue", 2); osc.add_bundle("/cue", 3); osc.end_bundle();
+        osc.send_bundle("127.0.0.1", 50040);
+        osc.begin_bundle(t10); osc.add_bundle("/cue", 1); osc.end_bundle();
+        osc.send_bundle("127.0.0.1", 50040);
+        osc.send("127.0.0.1", 50040, "/cue", 0);
+        osc.parse(); osc.parse(); osc.parse();
+        assert(got.size() == 1 && got[0] == 0);
+        assert(osc.getServer(50040).getScheduler().size() == 3);
+        delay(12); osc.parse();
+        assert(got.size() == 2 && got[1] == 1);
+        delay(10); osc.parse();
+        assert(got.size() == 4 && got[2] == 2 && got[3] == 3);
+        osc.getServer(50040).useScheduler(false);
+    }
+
+    // the message over the capacity of the queue is dispatched at once instead of dropped
+    got.clear();
+    osc.getServer(50040).useScheduler(true);
+    OscTimeTag later(OscClock.now() + OscClockManager::usToNtp(1000000));
+    for (int i = 0; i <= ARDUINOOSC_MAX_SCHEDULED_MSG_SIZE; ++i) {
+        osc.begin_bundle(later); osc.add_bundle("/cue", i); osc.end_bundle();
+        osc.send_bundle("127.0.0.1", 50040);
+        osc.parse();
+    }
+    assert(osc.getServer(50040).getScheduler().size() == ARDUINOOSC_MAX_SCHEDULED_MSG_SIZE);
+    assert(got.size() == 1 && got[0] == ARDUINOOSC_MAX_SCHEDULED_MSG_SIZE);
+    std::cout << "OK\n";
+}
@@ -0,0 +1,32 @@
+// compile-time typed message schema
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+int main() {
+    static_assert(OscSchema<float, float, float, float>::ARGS_SIZE == 16, "");
+    static_assert(OscSchema<int, int64_t, double>::TYPE_TAGS_SIZE == 8, "");
+    OscSchema<float, float, float, float> quat("/imu/quat");
+    assert(String(quat.typeTags()) == "ffff");
+    quat.encode(1.f, 2.f, 3.f, 4.f);
+    OscMessage m("/imu/quat"); m.pushFloat(1.f).pushFloat(2.f).pushFloat(3.f).pushFloat(4.f);
+    OscEncoder e; e.encode(m);
+    assert(quat.size() == e.size() && memcmp(quat.data(), e.data(), e.size()) == 0);
+    auto& osc = M::getInstance();
+    float w = 0, z = 0; int n = 0;
+    OscSchema<int, int64_t, double> mix("/mix");
+    for (int pass = 0; pass < 2; ++pass) {
+        osc.getServer(50100).useMessageView(pass == 1);
+        if (pass == 0) {
+            osc.subscribe(50100, quat, [&](float a, float, float, float d) { w = a; z = d; ++n; });
+            osc.subscribe(50100, mix, [&](int a, int64_t b, double c) { assert(a == -3 && b == (1LL << 40) && c == 0.25); ++n; });
+        }
+        osc.send("127.0.0.1", 50100, quat, 1.5f, 0, 0, -2.f);
+        osc.send("127.0.0.1", 50100, mix, -3, 1LL << 40, 0.25);
+        osc.send("127.0.0.1", 50100, "/imu/quat", 1.f, 2.f, 3);  // mismatch
+        osc.setParseBudget(0); osc.parse();
+        assert(w == 1.5f && z == -2.f && n == 2 * (pass + 1));
+    }
+    std::cout << "OK\n";
+}
@@ -0,0 +1,53 @@
+// receive statistics (ARDUINOOSC_ENABLE_STATS)
+#define ARDUINOOSC_ENABLE_STATS
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+int main() {
+    auto& osc = M::getInstance();
+    int hits = 0;
+    osc.subscribe(50160, "/a", [&](int) { ++hits; });
+    osc.subscribe(50160, "/p/*", [&](const OscMessage&) { ++hits; });
+    osc.send("127.0.0.1", 50160, "/a", 1);
+    osc.send("127.0.0.1", 50160, "/p/x", 1);
+    osc.send("127.0.0.1", 50160, "/none", 1);
+    uint8_t bad[8] = {'#', 'b', 0, 0, 0, 0, 0, 0};
+    mock_net()[50160].push_back(MockDatagram {std::vector<uint8_t>(bad, bad + 8), IPAddress(127, 0, 0, 1), 1});
+    for (int i = 0; i < 6; ++i) osc.parse();
+    auto& st = osc.getServerMap().at(50160)->stats();
+    assert(hits == 2);
+    assert(st.packets == 4 && st.messages == 3 && st.unmatched == 1 && st.parse_failures == 1);
+    assert(st.bytes > 0 && st.latency.count() == 2);
+    auto& subs = osc.getServer(50160).getDispatcher().getSubscriptions();
+    assert(subs[0].dispatched == 1 && subs[1].dispatched == 1);
+    assert(OscLatencyHistogram::bucketOf(0) == 0 && OscLatencyHistogram::bucketOf(1) == 0 && OscLatencyHistogram::bucketOf(2) == 1
+        && OscLatencyHistogram::bucketOf(1000) == std::min<size_t>(9, OscLatencyHistogram::NUM_BUCKETS - 1) && OscLatencyHistogram::bucketOf(0xFFFFFFFF) == OscLatencyHistogram::NUM_BUCKETS - 1);
+    // publish to a monitor
+    std::vector<uint32_t> got;
+    osc.subscribe(50161, "/stats", [&](const OscMessage& m) { got.clear(); for (size_t i = 0; i < m.size(); ++i) got.push_back(m.arg<int>(i)); });
+    size_t nb = 0;
+    osc.subscribe(50161, "/stats/latency", [&](const OscMessage& m) { nb = m.size(); });
+    osc.publishStats(50160, "127.0.0.1", 50161, "/stats", 1000.f);
+    osc.post();
+    osc.parse(); osc.parse(); osc.parse();
+    assert(got.size() == 6 && got[0] == 4 && got[5] == 1);
+    assert(nb == OscLatencyHistogram::NUM_BUCKETS);
+    osc.getServer(50160).resetStats();
+    assert(st.packets == 0 && subs[0].dispatched == 0);
+#ifndef MOCK_NOSTL
+    // messages posted to the worker are counted only if accepted, and without latency
+    OscDispatchWorker w;
+    auto& server = osc.getServer(50160);
+    server.useWorker(w);
+    for (int i = 0; i < ARDUINOOSC_WORKER_QUEUE_SIZE + 4; ++i) osc.send("127.0.0.1", 50160, "/a", i);
+    while (server.parse());
+    assert(w.dropped() == 4 && subs[0].dispatched == ARDUINOOSC_WORKER_QUEUE_SIZE);
+    assert(st.messages == ARDUINOOSC_WORKER_QUEUE_SIZE + 4 && st.latency.count() == 0);
+    hits = 0;
+    assert(w.drain() == ARDUINOOSC_WORKER_QUEUE_SIZE && hits == ARDUINOOSC_WORKER_QUEUE_SIZE);
+    server.useWorkers(nullptr, 0);
+#endif
+    std::cout << "OK\n";
+}
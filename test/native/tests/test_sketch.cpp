@@ -0,0 +1,7 @@
+// runs examples/test/test.ino on the host, failures are printed as "Failed"
+#include <MockUdp.h>
+#include <cassert>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#define delay(x)
+#include "examples/test/test.ino"
+int main() { setup(); }
@@ -0,0 +1,128 @@
+// SLIP framed stream transport: byte-at-a-time decoding, escaping and broken frames
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include "ArduinoOSC/OscSlip.h"
+#include <cassert>
+#include <deque>
+#include <iostream>
+#include <vector>
+
+// serial loopback, bytes written are read back
+struct LoopStream {
+    std::deque<uint8_t> q;
+    size_t num_writes {0};
+    int available() { return (int)q.size(); }
+    int read() {
+        if (q.empty()) return -1;
+        const uint8_t c = q.front();
+        q.pop_front();
+        return c;
+    }
+    size_t write(const uint8_t* buf, const size_t size) {
+        ++num_writes;
+        q.insert(q.end(), buf, buf + size);
+        return size;
+    }
+};
+
+using Slip = OscSlipTransport<LoopStream>;
+using M = ArduinoOSC::Manager<Slip>;
+using namespace arduino::osc;
+
+int main() {
+    auto& osc = M::getInstance();
+    LoopStream serial;
+    Slip::attach(50190, serial);
+    auto& server = osc.getServer(50190);
+
+    int i = 0;
+    std::vector<uint8_t> blob;
+    osc.subscribe(50190, "/i", i);
+    osc.subscribe(50190, "/b", [&](const OscMessage& m) {
+        Blob b = m.getArgAsBlob(0);
+        blob.assign(b.begin(), b.end());
+    });
+
+    // the client with the default port writes to the first stream
+    assert(osc.send("127.0.0.1", 9000, "/i", 123));
+    assert(serial.q.front() == slip::FRAME_END && serial.q.back() == slip::FRAME_END);
+    assert(server.parse() && i == 123);
+    assert(!server.parse());
+
+    // END and ESC in the payload are escaped
+    const uint8_t special[] = {slip::FRAME_END, slip::FRAME_ESC, 1, slip::FRAME_ESC, slip::FRAME_END};
+    OscMessage m("/b");
+    m.pushBlob(special, sizeof(special));
+    assert(osc.getClient().send("0.0.0.0", 0, m));
+    assert(server.parse());
+    assert(blob == std::vector<uint8_t>(special, special + sizeof(special)));
+
+    // the decoded frame is parsed in place, not copied into the receive buffer of the servers
+    const uint8_t* in_frame = nullptr;
+    osc.subscribe(50190, "/v", [&](const OscMessageView& v) {
+        size_t n = 0;
+        in_frame = v.getArgAsBlobPtr(0, n);
+    });
+    server.useMessageView(true);
+    m.init("/v").pushBlob(special, sizeof(special));
+    assert(osc.getClient().send("0.0.0.0", 0, m));
+    assert(server.parse());
+    const uint8_t* frame_data = OscUdpMapManager<Slip>::getInstance().getUdp(50190)->packetData();
+    assert(in_frame > frame_data && in_frame < frame_data + ARDUINOOSC_RX_BUFFER_SIZE);
+    server.useMessageView(false);
+
+    // frames arrive one byte per parse()
+    osc.send("127.0.0.1", 9000, "/i", 7);
+    std::deque<uint8_t> frame;
+    frame.swap(serial.q);
+    size_t calls = 0;
+    while (!frame.empty()) {
+        serial.q.push_back(frame.front());
+        frame.pop_front();
+        if (server.parse()) break;
+        ++calls;
+    }
+    assert(i == 7 && frame.empty() && calls > 8);
+
+#ifndef MOCK_NOSTL
+    // writes are batched
+    serial.num_writes = 0;
+    std::vector<uint8_t> large(200, 0x55);
+    m.init("/b").pushBlob(large.data(), large.size());
+    osc.getClient().send("0.0.0.0", 0, m);
+    assert(serial.num_writes == (serial.q.size() + ARDUINOOSC_SLIP_TX_BATCH_SIZE - 1) / ARDUINOOSC_SLIP_TX_BATCH_SIZE);
+    assert(server.parse() && blob.size() == 200);
+#else
+    // frames larger than ARDUINOOSC_RX_BUFFER_SIZE are dropped
+    std::vector<uint8_t> large(ARDUINOOSC_RX_BUFFER_SIZE + 1, 0x55);
+    serial.write(large.data(), large.size());
+    serial.write(&slip::FRAME_END, 1);
+    assert(!server.parse());
+    assert(osc.getUdpMap().front().second->dropped() == 1);
+#endif
+
+    // broken frames are dropped and the next frame is still received
+    const uint32_t dropped = osc.getUdpMap().front().second->dropped();
+    const uint8_t broken[] = {slip::FRAME_END, 'x', slip::FRAME_ESC, 'y', 'z', slip::FRAME_END, slip::FRAME_END};
+    serial.write(broken, sizeof(broken));
+    osc.send("127.0.0.1", 9000, "/i", 8);
+    while (server.parse());
+    assert(i == 8 && osc.getUdpMap().front().second->dropped() == dropped + 1);
+
+    // ESC immediately followed by END breaks the frame, and the next frame starts after the END
+    const uint8_t esc_end[] = {'x', 'y', slip::FRAME_ESC, slip::FRAME_END};
+    serial.write(esc_end, sizeof(esc_end));
+    osc.send("127.0.0.1", 9000, "/i", 9);
+    while (server.parse());
+    assert(i == 9 && osc.getUdpMap().front().second->dropped() == dropped + 2);
+    uint8_t tmp[4];
+    slip::Decoder dec(tmp, sizeof(tmp));
+    assert(dec.feed('a') == slip::Decoder::Result::PENDING && dec.feed(slip::FRAME_ESC) == slip::Decoder::Result::PENDING);
+    assert(dec.feed(slip::FRAME_END) == slip::Decoder::Result::BROKEN && dec.size() == 0);
+    assert(dec.feed('a') == slip::Decoder::Result::PENDING && dec.feed(slip::FRAME_END) == slip::Decoder::Result::COMPLETE && dec.size() == 1);
+
+    // nothing is sent without the stream
+    OscClient<Slip> detached(50191);
+    assert(!detached.send("0.0.0.0", 0, "/i", 1));
+    std::cout << "OK\n";
+}
@@ -0,0 +1,45 @@
+// encoding into a caller-provided buffer
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+int main() {
+    OscMessage m("/span"); m.pushInt32(1).pushString("hello").pushFloat(2.f);
+    OscEncoder e; e.encode(m);
+    uint8_t buf[128];
+    OscSpanEncoder se(buf, sizeof(buf));
+    se.encode(m);
+    assert(!se.overflow() && se.size() == e.size() && memcmp(se.data(), e.data(), e.size()) == 0);
+    assert(se.data() == buf);
+    OscDecoder d(se.data(), se.size()); const OscMessage* r = d.decode();
+    assert(r && r->arg<String>(1) == "hello");
+    // bundle into span
+    se.init().begin_bundle(OscTimeTag(5)).encode(m).encode(m).end_bundle();
+    OscEncoder eb; eb.begin_bundle(OscTimeTag(5)).encode(m).encode(m).end_bundle();
+    assert(!se.overflow() && se.size() == eb.size() && memcmp(se.data(), eb.data(), eb.size()) == 0);
+    // overflow
+    uint8_t small[16];
+    OscSpanEncoder so(small, sizeof(small));
+    so.encode(m);
+    assert(so.overflow());
+    so.init();
+    assert(!so.overflow() && so.size() == 0);
+    // the span is not limited by the storage of the encoder (ARDUINOOSC_MAX_MSG_BYTE_SIZE on NO-STL boards)
+    OscMessage large(String("/") + String(std::string(59, 'a')));
+    large.pushString(String(std::string(100, 'x')));
+    uint8_t big[256];
+    OscSpanEncoder sl(big, sizeof(big));
+    sl.encode(large);
+    assert(!sl.overflow() && sl.size() == 64 + 4 + 104);
+    OscEncoder el;
+    el.encode(large);
+#ifdef MOCK_NOSTL
+    assert(el.overflow());
+#else
+    assert(!el.overflow() && el.size() == sl.size() && memcmp(el.data(), sl.data(), sl.size()) == 0);
+#endif
+    // nested depth
+    OscEncoder n; for (int i = 0; i <= ARDUINOOSC_MAX_MSG_BUNDLE_DEPTH; ++i) n.begin_bundle();
+    assert(n.overflow());
+    std::cout << "OK\n";
+}
@@ -0,0 +1,92 @@
+// state cache: latest encoded message of every sent address, replied to /state/dump in bundles
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <cstring>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+
+int main() {
+    auto& osc = M::getInstance();
+    const auto& cache = osc.getStateCache();
+
+    // nothing is cached until it is enabled
+    osc.send("127.0.0.1", 50221, "/a", 0);
+    assert(cache.empty());
+    osc.serveState(50220);
+
+    // only the latest one is kept, as the bytes which were sent
+    osc.send("127.0.0.1", 50221, "/a", 1);
+    osc.send("127.0.0.1", 50221, "/a", 2);
+    assert(cache.size() == 1);
+    const MockDatagram last = mock_net()[50221].back();
+    const OscStateEntry* a = cache.find("/a");
+    assert(a && a->data.size() == last.data.size() && memcmp(a->data.data(), last.data.data(), last.data.size()) == 0);
+
+    // publishers are cached from the same pass
+    int value = 5;
+    osc.publish("127.0.0.1", 50221, "/mix/b", value);
+    osc.post();
+    assert(cache.size() == 2 && cache.find("/mix/b"));
+
+    // requests are not cached
+    osc.send("127.0.0.1", 50220, "/state/dump", 50222);
+    assert(cache.size() == 2);
+    mock_net()[50221].clear();
+
+    // the cache is replied in one bundle
+    osc.getServer(50220).parse();
+    assert(mock_pending(50222) == 1);
+    const MockDatagram d = mock_pop(50222);
+    assert(memcmp(d.data.data(), "#bundle", 8) == 0);
+    OscDecoder decoder;
+    assert(decoder.init(d.data.data(), d.data.size()));
+    OscMessage* m = decoder.decode();
+    assert(m && m->available() && m->address() == "/a" && m->arg<int>(0) == 2);
+    m = decoder.decode();
+    assert(m && m->available() && m->address() == "/mix/b" && m->arg<int>(0) == 5);
+    assert(!decoder.decode());
+
+    // filtered by the address prefix
+    osc.send("127.0.0.1", 50220, "/state/dump", 50222, "/mix");
+    osc.getServer(50220).parse();
+    assert(mock_pending(50222) == 1);
+    OscDecoder filtered;
+    const MockDatagram f = mock_pop(50222);
+    filtered.init(f.data.data(), f.data.size());
+    m = filtered.decode();
+    assert(m && m->address() == "/mix/b" && !filtered.decode());
+
+#ifndef MOCK_NOSTL
+    // split into the bundles up to mtu bytes
+    for (int i = 0; i < 40; ++i) osc.send("127.0.0.1", 50221, "/many/" + String(i), i, 1.5f);
+    mock_net()[50221].clear();
+    assert(cache.size() == 42);
+    osc.usePublishBatching(false, 256);
+    OscMessage req("/state/dump");
+    req.push(50222);
+    req.remoteIP(IPAddress(127, 0, 0, 1));
+    const size_t n = OscClientManager<MockUdp>::getInstance().dumpState(req);
+    assert(n > 1 && mock_pending(50222) == n);
+    size_t total = 0;
+    while (mock_pending(50222)) {
+        const MockDatagram b = mock_pop(50222);
+        assert(b.data.size() <= 256);
+        OscDecoder dec;
+        dec.init(b.data.data(), b.data.size());
+        while (OscMessage* r = dec.decode()) {
+            assert(r->available());
+            ++total;
+        }
+    }
+    assert(total == 42);
+#else
+    // addresses over the capacity are dropped
+    osc.send("127.0.0.1", 50221, "/c", 1);
+    osc.send("127.0.0.1", 50221, "/d", 1);
+    osc.send("127.0.0.1", 50221, "/e", 1);
+    assert(cache.size() == ARDUINOOSC_MAX_STATE_ENTRIES && cache.dropped() == 1);
+    mock_net()[50221].clear();
+#endif
+    std::cout << "OK\n";
+}
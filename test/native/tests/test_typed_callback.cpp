@@ -0,0 +1,33 @@
+// subscribeTyped() with lambdas and function pointers
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+static int fp_hits = 0; static double fp_d = 0;
+void onD(double d, int32_t h) { ++fp_hits; fp_d = d + (double)h; }
+int main() {
+    auto& osc = M::getInstance();
+    int gi = 0; float gx = 0, gy = 0; int n = 0;
+    osc.subscribeTyped(50150, "/pos", [&](int32_t id, float x, float y) { ++n; gi = id; gx = x; gy = y; });
+    osc.subscribeTyped(50150, "/d", &onD);
+    osc.subscribeTyped(50150, "/d2", onD);
+    OscSchema<float, int> sc("/sc");
+    float sf = 0; int si = 0;
+    osc.subscribe(50150, sc, [&](float f, int i) { sf = f; si = i; });
+    osc.send("127.0.0.1", 50150, "/pos", 3, 1.5f, 2.5f);
+    osc.send("127.0.0.1", 50150, "/pos", 3.0f, 1.5f, 2.5f);  // mismatch
+    osc.send("127.0.0.1", 50150, "/pos", 4, 1.5f);            // mismatch
+    osc.send("127.0.0.1", 50150, "/d", 1.25, 2);
+    osc.send("127.0.0.1", 50150, "/d2", 1.25, 3);
+    osc.send("127.0.0.1", 50150, sc, 0.5f, 9);
+    for (int i = 0; i < 8; ++i) osc.parse();
+    assert(n == 1 && gi == 3 && gx == 1.5f && gy == 2.5f);
+    assert(fp_hits == 2 && fp_d == 4.25);
+    assert(sf == 0.5f && si == 9);
+    osc.getServer(50150).useMessageView(true);
+    osc.send("127.0.0.1", 50150, "/pos", 7, 3.5f, 4.5f);
+    osc.parse();
+    assert(n == 2 && gi == 7 && gy == 4.5f);
+    std::cout << "OK\n";
+}
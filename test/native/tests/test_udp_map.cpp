@@ -0,0 +1,55 @@
+// udp refs cached by clients and servers stay valid when port 9 is rebound to a server port
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+using M = ArduinoOSC::Manager<MockUdp>;
+using arduino::osc::PORT_DISCARD;
+int main() {
+    auto& osc = M::getInstance();
+    auto& udp_map = osc.getUdpMap();
+
+    // client created before any server binds the discard port
+    OscClient<MockUdp> client;
+    assert(client.send("127.0.0.1", 50160, "/a", 1));
+    assert(udp_map.size() == 1 && udp_map.front().first == PORT_DISCARD);
+    const MockUdp* first = udp_map.front().second.get();
+    assert(client.localPort() == PORT_DISCARD);
+
+    // the server takes over the same instance, so the client keeps sending from it
+    int value = 0;
+    osc.subscribe(50160, "/a", value);
+    auto& server = osc.getServer(50160);
+    assert(server.parse() && value == 1);
+    assert(udp_map.size() == 1 && udp_map.front().first == 50160);
+    assert(udp_map.front().second.get() == first);
+    assert(client.localPort() == 50160);
+    assert(client.send("127.0.0.1", 50160, "/a", 2));
+    assert(server.parse() && value == 2);
+
+    // another port is added without moving the cached one
+    int other = 0;
+    osc.subscribe(50161, "/b", other);
+    client.localPort(50161);
+    assert(client.send("127.0.0.1", 50160, "/a", 3));
+    assert(osc.getServer(50160).parse() && value == 3);
+    assert(udp_map.size() == 2 && udp_map.front().second.get() == first);
+    assert(client.localPort() == 50161);
+
+    // the discard port now means the first udp
+    OscClient<MockUdp> late;
+    assert(late.localPort() == 50160);
+
+#ifdef MOCK_NOSTL
+    // the port over the capacity is not bound instead of aliased to another udp
+    OscClient<MockUdp> over(50162);
+    assert(!over.send("127.0.0.1", 50160, "/a", 4) && over.lastResult() == OscClient<MockUdp>::TX_BEGIN_FAILED);
+    assert(over.localPort() == 0 && udp_map.size() == ARDUINOOSC_MAX_SUBSCRIBE_PORTS && mock_pending(50160) == 0);
+    int lost = 0;
+    osc.subscribe(50162, "/c", lost);
+    assert(late.send("127.0.0.1", 50162, "/c", 5));
+    assert(!osc.getServer(50162).parse() && osc.getServerMap().size() == ARDUINOOSC_MAX_SUBSCRIBE_PORTS);
+    assert(mock_pending(50162) == 1 && lost == 0);
+#endif
+    std::cout << "OK\n";
+}
@@ -0,0 +1,90 @@
+// dispatch workers: matched messages are posted to the MPSC queues and called in drain()
+#include <MockUdp.h>
+#include "ArduinoOSC/ArduinoOSCCommon.h"
+#include <cassert>
+#include <iostream>
+#ifndef MOCK_NOSTL
+#include <atomic>
+#include <thread>
+using M = ArduinoOSC::Manager<MockUdp>;
+
+int main() {
+    auto& osc = M::getInstance();
+    auto& server = osc.getServer(50310);
+    OscDispatchWorker workers[2];
+    server.useWorkers(workers, 2);
+
+    // callbacks are deferred to drain()
+    int a = 0, b = 0;
+    String who;
+    osc.subscribe(50310, "/a", a);
+    osc.subscribe(50310, "/b/*", [&](const OscMessage& m) { b = m.arg<int>(0); who = m.remoteIP(); });
+    osc.send("127.0.0.1", 50310, "/a", 1);
+    osc.send("127.0.0.1", 50310, "/b/x", 2);
+    while (server.parse());
+    assert(a == 0 && b == 0);
+    assert(workers[0].pending() + workers[1].pending() == 2);
+    assert(workers[0].drain() + workers[1].drain() == 2);
+    assert(a == 1 && b == 2 && who == "127.0.0.1");
+
+    // same for the message view path
+    server.useMessageView(true);
+    osc.send("127.0.0.1", 50310, "/a", 3);
+    server.parse();
+    assert(a == 1);
+    workers[0].drain();
+    workers[1].drain();
+    assert(a == 3);
+    server.useMessageView(false);
+
+    // overflow and oversized messages are counted
+    OscDispatchWorker& wa = workers[server.getDispatcher().getSubscriptions()[0].hash % 2];
+    for (int i = 0; i < 20; ++i) osc.send("127.0.0.1", 50310, "/a", i);
+    while (server.parse());
+    assert(wa.pending() == 16 && wa.dropped() == 4);
+    assert(wa.drain(10) == 10 && wa.drain() == 6 && a == 15);
+    OscMessage big("/a");
+    String s;
+    for (int i = 0; i < 300; ++i) s += 'x';
+    big.push(s);
+    assert(!wa.post(server.getDispatcher().getSubscriptions()[0].ref.get(), big));
+    assert(wa.oversized() == 1 && wa.pending() == 0);
+
+    // the messages of each producer are called in order on the worker thread
+    OscDispatchWorker w;
+    std::atomic<int> last[2] = {{-1}, {-1}};
+    std::atomic<bool> in_order {true};
+    osc.subscribe(50311, "/p/0", [&](int i) { in_order = in_order && (i > last[0]); last[0] = i; });
+    osc.subscribe(50311, "/p/1", [&](int i) { in_order = in_order && (i > last[1]); last[1] = i; });
+    auto& subs = osc.getServer(50311).getDispatcher().getSubscriptions();
+    std::atomic<bool> done {false};
+    std::thread consumer([&]() {
+        while (!done || w.pending()) w.drain();
+    });
+    const int total = 20000;
+    auto producer = [&](const size_t k) {
+        OscEncoder enc;
+        for (int i = 0; i < total; ++i) {
+            OscMessage m(String("/p/") + String((int)k));
+            m.push(i);
+            enc.init().encode(m);
+            OscMessageView v(enc.data(), enc.size());
+            while (!w.post(subs[k].ref.get(), v)) std::this_thread::yield();
+        }
+    };
+    std::thread p0(producer, 0), p1(producer, 1);
+    p0.join();
+    p1.join();
+    done = true;
+    consumer.join();
+    assert(in_order);
+    assert(last[0] == total - 1 && last[1] == total - 1);
+    assert(w.posted() == 2 * total);
+
+    std::cout << "OK\n";
+}
+#else
+int main() {
+    std::cout << "OK\n";  // workers need STL
+}
+#endif